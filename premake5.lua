@@ -1,7 +1,9 @@
 local path = require("path")
 
 function findQtInstallation()
-    local qtInstallRoot = os.getenv("QTDIR") or "C:/Qt"
+    -- the online installer puts Qt in C:/Qt on windows and ~/Qt on linux
+    local defaultRoot = os.ishost("windows") and "C:/Qt" or path.join(os.getenv("HOME") or "", "Qt")
+    local qtInstallRoot = os.getenv("QTDIR") or defaultRoot
     local qtVersions = os.matchdirs(qtInstallRoot .. "/6.*")
 
     if #qtVersions == 0 then
@@ -10,17 +12,18 @@ function findQtInstallation()
 
     table.sort(qtVersions)
     local latestQt = qtVersions[#qtVersions]
-    local compilerDirs = os.matchdirs(latestQt .. "/msvc*")
+    local compiler = os.ishost("windows") and "msvc*" or "gcc_*"
+    local compilerDirs = os.matchdirs(latestQt .. "/" .. compiler)
 
     if #compilerDirs == 0 then
-        error("No MSVC compiler folder found in Qt installation at: " .. latestQt)
+        error("No " .. compiler .. " compiler folder found in Qt installation at: " .. latestQt)
     end
 
     return compilerDirs[#compilerDirs]
 end
 qtDir = findQtInstallation()
 
-function runWindeployQt(qtDir, targetDir, debug)
+function runWindeployQt(qtDir, targetDir, debug, exeName)
     local windeployqt = path.join(qtDir, "bin", "windeployqt.exe")
     local modeFlag = debug and "--debug" or "--release"
 
@@ -29,7 +32,7 @@ function runWindeployQt(qtDir, targetDir, debug)
         string.format('if not exist "%s" mkdir "%s"', targetDir, targetDir),
 
         -- Run windeployqt on the built executable with correct flag
-        string.format('"%s" %s "%s/H1ModTools.exe"', windeployqt, modeFlag, targetDir)
+        string.format('"%s" %s "%s/%s.exe"', windeployqt, modeFlag, targetDir, exeName or "H1ModTools")
     }
 end
 
@@ -61,30 +64,112 @@ project "H1ModTools"
     qt.enable()
     qtuseexternalinclude(true)
     qtpath(qtDir)
-    qtmodules { "core", "gui", "widgets" }
+    qtmodules { "core", "gui", "widgets", "concurrent" }
     qtprefix "Qt6"
 
     -- Copy static files to build folder
     local staticSource = path.getabsolute("static")
     local staticDest = path.join(path.translate("%{cfg.targetdir}"), "static")
-    postbuildcommands {
-        string.format('cmd /c robocopy "%s" "%s" /e /nfl /ndl /njh /njs /nc /ns /np > nul 2>&1 ^& exit 0', staticSource, staticDest)
-    }
+
+    filter "system:windows"
+        postbuildcommands {
+            string.format('cmd /c robocopy "%s" "%s" /e /nfl /ndl /njh /njs /nc /ns /np > nul 2>&1 ^& exit 0', staticSource, staticDest)
+        }
+
+    -- Headless batch export machines, premake5 gmake2 and make. Qt's own libraries
+    -- are found through the rpath instead of being deployed next to the binary.
+    filter "system:linux"
+        removefiles { "src/**.rc" }
+        links { "pthread" }
+        linkoptions { "-Wl,-rpath," .. path.join(qtDir, "lib") }
+
+        postbuildcommands {
+            string.format('mkdir -p "%s" && cp -r "%s/." "%s"', staticDest, staticSource, staticDest)
+        }
 
     filter "configurations:Debug"
-        qtsuffix "d"
         defines { "DEBUG" }
         symbols "On"
 
+    filter "configurations:Release"
+        defines { "NDEBUG" }
+        optimize "On"
+
+    filter { "system:windows", "configurations:Debug" }
+        qtsuffix "d"
         postbuildcommands(runWindeployQt(qtDir, path.translate("%{cfg.targetdir}"), true))
 
+    filter { "system:windows", "configurations:Release" }
+        postbuildcommands(runWindeployQt(qtDir, path.translate("%{cfg.targetdir}"), false))
+
+    filter "action:vs*"
+        buildoptions { "/Zc:__cplusplus" }
+
+    filter {}
+
+-- zonetool.exe stand-in for running the worker protocol without the game, see tools/ZonetoolStandIn
+project "ZonetoolStandIn"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+
+    targetname "zonetool"
+    targetdir "%{wks.location}/bin/%{cfg.platform}/%{cfg.buildcfg}/standin"
+
+    files { "tools/ZonetoolStandIn/**.cpp" }
+
+    filter "configurations:Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        optimize "On"
+
+    filter {}
+
+-- ProcessRunner's worker mode against the stand-in, run it from the target folder so it finds standin/
+project "ProcessRunnerTest"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++23"
+
+    dependson { "ZonetoolStandIn" }
+
+    files {
+        "tools/ProcessRunnerTest/**.h", "tools/ProcessRunnerTest/**.cpp",
+        "src/ProcessRunner.h", "src/ProcessRunner.cpp",
+        "src/ProcessTelemetry.h", "src/ProcessTelemetry.cpp",
+        "src/Utils/LineRingBuffer.h", "src/Utils/LineRingBuffer.cpp"
+    }
+    includedirs { "src" }
+
+    local qt = premake.extensions.qt
+
+    qt.enable()
+    qtuseexternalinclude(true)
+    qtpath(qtDir)
+    qtmodules { "core", "gui", "widgets", "test" }
+    qtprefix "Qt6"
+
+    filter "system:linux"
+        links { "pthread" }
+        linkoptions { "-Wl,-rpath," .. path.join(qtDir, "lib") }
+
+    filter "configurations:Debug"
+        defines { "DEBUG" }
+        symbols "On"
+
     filter "configurations:Release"
         defines { "NDEBUG" }
         optimize "On"
 
-        postbuildcommands(runWindeployQt(qtDir, path.translate("%{cfg.targetdir}"), false))
+    filter { "system:windows", "configurations:Debug" }
+        qtsuffix "d"
+        postbuildcommands(runWindeployQt(qtDir, path.translate("%{cfg.targetdir}"), true, "ProcessRunnerTest"))
+
+    filter { "system:windows", "configurations:Release" }
+        postbuildcommands(runWindeployQt(qtDir, path.translate("%{cfg.targetdir}"), false, "ProcessRunnerTest"))
 
     filter "action:vs*"
         buildoptions { "/Zc:__cplusplus" }
 
-    filter {}
\ No newline at end of file
+    filter {}
@@ -0,0 +1,147 @@
+#include "GSCWatcher.h"
+
+GSCWatcher::GSCWatcher(QObject* parent)
+    : QObject(parent)
+{
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(150);
+
+    connect(&m_debounce, &QTimer::timeout, this, &GSCWatcher::convertPending);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &GSCWatcher::onFileChanged);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &GSCWatcher::onDirectoryChanged);
+}
+
+void GSCWatcher::start(const QString& folder, const GSC_Convert_Settings& settings, std::function<void()> onNewScripts)
+{
+    stop();
+
+    m_folder = folder;
+    m_settings = settings;
+    m_onNewScripts = std::move(onNewScripts);
+
+    watchTree();
+
+    qInfo() << "Watching" << m_watcher.files().size() << "GSC files in" << folder;
+}
+
+void GSCWatcher::stop()
+{
+    if (!isWatching())
+        return;
+
+    m_debounce.stop();
+
+    if (!m_watcher.files().isEmpty())
+        m_watcher.removePaths(m_watcher.files());
+    if (!m_watcher.directories().isEmpty())
+        m_watcher.removePaths(m_watcher.directories());
+
+    qInfo() << "Stopped watching GSC files in" << m_folder;
+
+    m_folder.clear();
+    m_pending.clear();
+    m_written.clear();
+    m_hasNewScripts = false;
+}
+
+void GSCWatcher::watchTree()
+{
+    QStringList paths{ m_folder };
+
+    QDirIterator it(m_folder, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        const QString dir = it.next();
+        if (!dir.contains("/.gsc_cache"))
+            paths << dir;
+    }
+
+    paths << findAllGSCFiles(m_folder);
+
+    // already watched paths are just reported back as failed
+    const QStringList watched = m_watcher.files() + m_watcher.directories();
+    QStringList added;
+    for (const QString& path : paths)
+    {
+        if (!watched.contains(path))
+            added << path;
+    }
+
+    if (!added.isEmpty())
+        m_watcher.addPaths(added);
+}
+
+void GSCWatcher::onFileChanged(const QString& path)
+{
+    const QFileInfo info(path);
+
+    // editors that save through a rename drop the watch, pick the new file up again
+    if (info.exists() && !m_watcher.files().contains(path))
+        m_watcher.addPath(path);
+
+    if (!info.exists())
+        return;
+
+    const auto written = m_written.constFind(path);
+    if (written != m_written.constEnd() && *written == info.lastModified())
+        return;
+
+    m_pending.insert(path);
+    m_debounce.start();
+}
+
+void GSCWatcher::onDirectoryChanged(const QString& path)
+{
+    const QStringList before = m_watcher.files();
+    watchTree();
+
+    for (const QString& file : m_watcher.files())
+    {
+        if (!before.contains(file))
+        {
+            m_pending.insert(file);
+            m_hasNewScripts = true;
+        }
+    }
+
+    if (!m_pending.isEmpty())
+        m_debounce.start();
+}
+
+void GSCWatcher::convertPending()
+{
+    // one conversion at a time writes the manifest, changes coming in meanwhile wait for the next round
+    if (m_converting)
+        return;
+
+    if (m_pending.isEmpty())
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const QStringList files(m_pending.cbegin(), m_pending.cend());
+    const bool hasNewScripts = m_hasNewScripts;
+    m_pending.clear();
+    m_hasNewScripts = false;
+
+    m_converting = true;
+    ConvertGSCFiles(m_folder, m_settings, this, [this, files, hasNewScripts, timer, folder = m_folder](bool) {
+        m_converting = false;
+
+        if (!m_pending.isEmpty())
+            m_debounce.start();
+
+        // stopped or moved on to another zone while converting
+        if (folder != m_folder)
+            return;
+
+        for (const QString& file : files)
+            m_written.insert(file, QFileInfo(file).lastModified());
+
+        if (hasNewScripts && m_onNewScripts)
+            m_onNewScripts();
+
+        qInfo() << "Converted" << files.size() << "changed GSC files in" << timer.elapsed() << "ms";
+    }, files);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Globals.h"
+
+#include "Utils/GSC.h"
+
+// Watches a zone's scripts and converts the ones that get saved, a short
+// debounce folds the burst of change events editors produce per save
+class GSCWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GSCWatcher(QObject* parent = nullptr);
+
+    // onNewScripts runs after converting scripts that weren't there before, their rawfile rows are missing from the csv
+    void start(
+        const QString& folder,
+        const GSC_Convert_Settings& settings,
+        std::function<void()> onNewScripts = {}
+    );
+    void stop();
+
+    bool isWatching() const { return !m_folder.isEmpty(); }
+    const QString& folder() const { return m_folder; }
+
+private:
+    void watchTree();
+    void onFileChanged(const QString& path);
+    void onDirectoryChanged(const QString& path);
+    void convertPending();
+
+    QFileSystemWatcher m_watcher;
+    QTimer m_debounce;
+
+    QString m_folder;
+    GSC_Convert_Settings m_settings{};
+    std::function<void()> m_onNewScripts;
+
+    QSet<QString> m_pending;
+    bool m_hasNewScripts = false;
+    bool m_converting = false; // a conversion is running on the thread pool
+
+    // what our own writes left behind, so they don't trigger another conversion
+    QHash<QString, QDateTime> m_written;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Globals.h"
+
+#include <array>
+
+// Per source game layout of the export pipeline, everything here is known at compile time
+template <GameType Game>
+struct GameTraits;
+
+template <>
+struct GameTraits<IW3>
+{
+    static constexpr GameType type = IW3;
+    static constexpr QLatin1String name{ "iw3" };
+
+    static constexpr QLatin1String dumpExecutable{ "zonetool_iw3.exe" };
+    static constexpr QLatin1String assetsPath{ "zonetool_assets/iw3" }; // addpaths entry of generated csvs
+    static constexpr QLatin1String gscRulesPath{ "static/gsc_rules/iw3.json" };
+
+    // .map sources that get compiled with cod4map before they can be dumped
+    static constexpr bool hasMapSources = true;
+
+    // asset types copied over from the dumped zone's own csv
+    static constexpr std::array<QLatin1String, 4> loadedAssetTypes{
+        QLatin1String("rawfile"), QLatin1String("sound"), QLatin1String("xmodel"), QLatin1String("xanim") };
+
+    static const QString& gamePath() { return Globals.pathIW3; }
+};
+
+template <>
+struct GameTraits<IW4>
+{
+    static constexpr GameType type = IW4;
+    static constexpr QLatin1String name{ "iw4" };
+
+    static constexpr QLatin1String dumpExecutable{ "zonetool_iw4.exe" };
+    static constexpr QLatin1String assetsPath{ "zonetool_assets/iw4" };
+    static constexpr QLatin1String gscRulesPath{ "static/gsc_rules/iw4.json" };
+
+    static constexpr bool hasMapSources = false;
+
+    static constexpr std::array<QLatin1String, 4> loadedAssetTypes{
+        QLatin1String("rawfile"), QLatin1String("sound"), QLatin1String("xmodel"), QLatin1String("xanim") };
+
+    static const QString& gamePath() { return Globals.pathIW4; }
+};
+
+template <>
+struct GameTraits<IW5>
+{
+    static constexpr GameType type = IW5;
+    static constexpr QLatin1String name{ "iw5" };
+
+    static constexpr QLatin1String dumpExecutable{ "zonetool_iw5.exe" };
+    static constexpr QLatin1String assetsPath{ "zonetool_assets/iw5" };
+    static constexpr QLatin1String gscRulesPath{ "static/gsc_rules/iw5.json" };
+
+    static constexpr bool hasMapSources = false;
+
+    static constexpr std::array<QLatin1String, 4> loadedAssetTypes{
+        QLatin1String("rawfile"), QLatin1String("sound"), QLatin1String("xmodel"), QLatin1String("xanim") };
+
+    static const QString& gamePath() { return Globals.pathIW5; }
+};
+
+// Picks the traits for a runtime source game once, so the pipeline behind it doesn't branch on it again.
+// visitor gets a GameTraits<...> value, every instantiation has to return the same type.
+template <typename Visitor>
+decltype(auto) visitSourceGame(GameType gameType, Visitor&& visitor)
+{
+    switch (gameType)
+    {
+    case IW3: return visitor(GameTraits<IW3>{});
+    case IW4: return visitor(GameTraits<IW4>{});
+    case IW5: return visitor(GameTraits<IW5>{});
+    default:
+        // H1 is never a source game, callers check before dispatching
+        qFatal("visitSourceGame: %d is not a source game", static_cast<int>(gameType));
+    }
+}
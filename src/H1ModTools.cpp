@@ -6,6 +6,10 @@
 #include "Utils/MapEnts.h"
 #include "Utils/CSVGenerator.h"
 #include "Utils/CSV.h"
+#include "Utils/AssetVerifier.h"
+#include "Utils/GSCLint.h"
+#include "GameTraits.h"
+#include "Utils/BuildCache.h"
 
 const QStringList languageFolders = {
         "english", "french", "german", "spanish",
@@ -227,11 +231,29 @@ H1ModTools::H1ModTools(QWidget *parent)
 
     logger = std::make_unique<LogRedirector>(ui.outputBuffer);
     logger->installQtMessageHandler();
+    logger->fileWriter().setCompressOldSegments(QSettings().value("CompressOldLogs", false).toBool());
 
     ui.outputBuffer->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(ui.outputBuffer, &QWidget::customContextMenuRequested,
         this, &H1ModTools::onOutputBufferContextMenu);
 
+    m_copyOutputAction = new QAction("Copy", ui.outputBuffer);
+    m_copyOutputAction->setShortcut(QKeySequence::Copy);
+    m_copyOutputAction->setShortcutContext(Qt::WidgetShortcut);
+    ui.outputBuffer->addAction(m_copyOutputAction);
+    connect(m_copyOutputAction, &QAction::triggered, this, &H1ModTools::copyOutputSelection);
+
+    // Filtering happens in the model, the view never sees the lines left out
+    connect(ui.logSearchEdit, &QLineEdit::textChanged, this, &H1ModTools::applyLogFilter);
+    for (auto* checkBox : { ui.logDebugCheckBox, ui.logInfoCheckBox, ui.logWarningCheckBox, ui.logErrorCheckBox })
+        connect(checkBox, &QCheckBox::toggled, this, &H1ModTools::applyLogFilter);
+
+    const LogModel* logModel = logger->model();
+    connect(logModel, &QAbstractItemModel::rowsInserted, this, &H1ModTools::updateLogLineCount);
+    connect(logModel, &QAbstractItemModel::rowsRemoved, this, &H1ModTools::updateLogLineCount);
+    connect(logModel, &QAbstractItemModel::modelReset, this, &H1ModTools::updateLogLineCount);
+    updateLogLineCount();
+
     loadGlobals();
 
     setupListWidgets(); // Once at init
@@ -239,6 +261,11 @@ H1ModTools::H1ModTools(QWidget *parent)
 
     connect(ui.tabWidget, &QTabWidget::currentChanged, this, &H1ModTools::updateVisibility);
     updateVisibility();
+
+    connect(ui.watchGscCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        if (!checked)
+            m_gscWatcher.stop();
+    });
 }
 
 H1ModTools::~H1ModTools()
@@ -248,6 +275,9 @@ void H1ModTools::on_settingsButton_clicked()
 {
     SettingsDialog dlg(this);
     if (dlg.exec() == QDialog::Accepted) {
+        // workers belong to the old tool paths, or aren't wanted anymore
+        m_runner.stopWorkers();
+        logger->fileWriter().setCompressOldSegments(QSettings().value("CompressOldLogs", false).toBool());
         populateLists();
     }
 }
@@ -530,6 +560,8 @@ GameType H1ModTools::getCurrentGameType()
     return H1;
 }
 
+static const QString BuildCacheFolder = ".h1modtools_cache";
+
 void H1ModTools::on_buildAndExportButton_clicked()
 {
     if (!treeWidgetIW3->currentItem() || !treeWidgetIW3->currentItem()->parent())
@@ -561,11 +593,32 @@ void H1ModTools::on_buildAndExportButton_clicked()
 
     const auto lightOptions = lightFlags.join(' ');
 
-    disableUiAndStoreState();
-
     // build BSP, reflections, & IW3 fastfile using their mod tools
     // this also handles the rest of the entire process
-    compileIW3Map(mapName, Globals.pathIW3, lightOptions);
+    auto* graph = new JobGraph(m_runner, this);
+
+    // steps whose inputs didn't change restore their outputs instead of running
+    std::shared_ptr<BuildCache> cache;
+    if (ui.buildCacheCheckBox->isChecked())
+        cache = std::make_shared<BuildCache>(Globals.pathIW3 + "/" + BuildCacheFolder);
+
+    const auto compiled = compileIW3Map(*graph, cache, mapName, Globals.pathIW3, lightOptions);
+    const auto reflections = compiled < 0 ? -1 : compileIW3MapReflections(*graph, cache, mapName, Globals.pathIW3, compiled);
+    const auto fastfiles = reflections < 0 ? -1 : buildIW3MapFastfile(*graph, cache, mapName, Globals.pathIW3, reflections);
+
+    if (fastfiles < 0) {
+        graph->deleteLater();
+        return;
+    }
+
+    disableUiAndStoreState();
+    m_runner.telemetry().reset();
+
+    graph->run([this, graph, mapName](bool) {
+        reportProcessTelemetry("build_" + mapName);
+        restoreUiState();
+        graph->deleteLater();
+    });
 }
 
 void H1ModTools::on_exportButton_clicked()
@@ -573,6 +626,11 @@ void H1ModTools::on_exportButton_clicked()
     exportSelection();
 }
 
+void H1ModTools::on_dryRunGscButton_clicked()
+{
+    dryRunSelection();
+}
+
 void H1ModTools::on_buildZoneButton_clicked()
 {
     const QString executable = "zonetool.exe";
@@ -590,35 +648,92 @@ void H1ModTools::on_buildZoneButton_clicked()
     const QString currentSelectedText = treeWidgetH1->currentItem()->text(0);
     const QString currentSelectedZone = QFileInfo(currentSelectedText).completeBaseName();
 
-    const auto isMap = Funcs::H1::isMap(currentSelectedZone) || Funcs::H1::isMapLoad(currentSelectedZone);
+    startPipeline("Building zone " + currentSelectedZone, [this, file, currentSelectedZone](CancellationToken token) {
+        return buildZone(file, currentSelectedZone, token);
+    });
+}
+
+Task<void> H1ModTools::buildZone(QFileInfo zonetool, QString zone, CancellationToken token)
+{
+    const auto isMap = Funcs::H1::isMap(zone) || Funcs::H1::isMapLoad(zone);
 
     QStringList arguments;
-    arguments << "-unbuffered-io" <<
-    arguments << "-buildzone" << currentSelectedZone;
+    arguments << "-unbuffered-io";
+    arguments << "-buildzone" << zone;
+
+    // fail fast on missing assets instead of minutes into the zonetool build
+    int expectedAssets = 0;
+    if (QFile::exists(Globals.pathH1 + "/zone_source/" + zone + ".csv")) {
+        auto verifying = runInPool([zone]() { return verifyZoneSourceAssets(zone, GameType::H1); }, token);
+        const auto verify = co_await verifying;
+
+        expectedAssets = verify.checkedCount + verify.skippedCount;
+        qDebug() << "Verified" << verify.checkedCount << "assets for zone" << zone
+            << "in" << verify.elapsedMs << "ms (" << verify.skippedCount << "skipped )";
+
+        if (!verify.skippedTypes.isEmpty()) {
+            QStringList skipped;
+            for (auto it = verify.skippedTypes.cbegin(); it != verify.skippedTypes.cend(); ++it)
+                skipped << QString("%1 (%2)").arg(it.key()).arg(it.value());
+            qInfo().noquote() << "Not checked, no known file layout for:" << skipped.join(", ");
+        }
 
-    qDebug() << "Building zone" << currentSelectedZone;
+        if (!verify.ok()) {
+            for (const QString& asset : verify.missing)
+                qCritical() << "Missing asset:" << asset;
+            qCritical() << "Failed to build zone" << zone << "due to" << verify.missing.size() << "missing assets";
+            co_return;
+        }
+    }
 
-    disableUiAndStoreState();
+    // calls H1 doesn't know only show up once the map loads in game, the lint only warns so it runs alongside the build
+    const QString zoneFolder = Globals.pathH1 + "/zonetool/" + zone;
+    auto linting = runInPool([zoneFolder]() {
+        return QDir(zoneFolder).exists() ? GSC::lint(GSC::SymbolIndex::build(zoneFolder)) : GSC::LintReport{};
+    }, token);
 
-    m_runner.run(file, arguments, [this, executable, currentSelectedZone, isMap](int exitCode) {
-        qDebug() << executable << "finished with exit code" << exitCode;
-        if (exitCode != EXIT_SUCCESS) {
-            qCritical() << "Failed to build zone" << currentSelectedZone;
-            restoreUiState();
-            return;
-        }
-        // Move map files to usermaps
-        if (ui.moveToUsermapsCheckBox->isChecked()) {
-            if (isMap && !Funcs::H1::moveToUsermaps(currentSelectedZone)) {
-                qWarning() << "Failed to move" << currentSelectedZone << "to usermaps";
-            }
-            else if (isMap) {
-                qDebug() << "Moved" << currentSelectedZone << "to usermaps";
-            }
-        }
-        qDebug() << "Compiled zone" << currentSelectedZone;
-        restoreUiState();
-    });
+    qDebug() << "Building zone" << zone;
+
+    const auto progress = beginZonetoolProgress(zone, "build", expectedAssets);
+    auto endProgress = qScopeGuard([this, progress]() { endZonetoolProgress(progress, "build", false); });
+    const auto onProgressLine = zonetoolLineHandler(progress);
+
+    // -unbuffered-io makes zonetool flush every line, so arrival times are close to when they were printed
+    auto hotspots = std::make_shared<ZonetoolHotspots>();
+    const auto onLine = [hotspots, onProgressLine](QByteArrayView line, qint64 receivedUs) {
+        hotspots->feed(line, receivedUs);
+        onProgressLine(line, receivedUs);
+    };
+
+    hotspots->start(m_runner.elapsedUs());
+    auto building = runZonetool(zonetool, arguments, onLine, token);
+    const auto [exitCode, lint] = co_await whenAll(std::move(building), std::move(linting));
+
+    for (const auto& issue : lint.unresolved)
+        qWarning().noquote() << QString("%1:%2: unresolved call to %3").arg(issue.path).arg(issue.line).arg(issue.call);
+    qDebug() << "Checked" << lint.checkedCalls << "GSC calls in" << lint.elapsedMs << "ms ("
+        << lint.externalCalls << "external," << lint.unresolved.size() << "unresolved )";
+
+    qDebug() << zonetool.fileName() << "finished with exit code" << exitCode;
+    endProgress.dismiss();
+    endZonetoolProgress(progress, "build", exitCode == EXIT_SUCCESS);
+    reportProcessTelemetry("buildzone_" + zone);
+    reportZonetoolHotspots(*hotspots, zone);
+
+    if (exitCode != EXIT_SUCCESS) {
+        qCritical() << "Failed to build zone" << zone;
+        co_return;
+    }
+
+    // Move map files to usermaps
+    if (isMap && ui.moveToUsermapsCheckBox->isChecked()) {
+        if (!Funcs::H1::moveToUsermaps(zone))
+            qWarning() << "Failed to move" << zone << "to usermaps";
+        else
+            qDebug() << "Moved" << zone << "to usermaps";
+    }
+
+    qDebug() << "Compiled zone" << zone;
 }
 
 void H1ModTools::on_compileReflectionsButton_clicked()
@@ -666,21 +781,29 @@ void H1ModTools::on_compileReflectionsButton_clicked()
 
     qDebug() << "Generating reflection probes for zone" << currentSelectedZone;
 
-    disableUiAndStoreState();
+    startPipeline("Generating reflection probes for " + currentSelectedZone, [this, file, arguments, currentSelectedZone](CancellationToken token) {
+        return compileReflections(file, arguments, currentSelectedZone, token);
+    });
+}
 
-    m_runner.run(file, arguments, [this, executable, currentSelectedZone](int exitCode) {
-        qDebug() << executable << "finished with exit code" << exitCode;
-        if (exitCode != EXIT_SUCCESS) {
-            qCritical() << "Failed to generate reflection probes for zone" << currentSelectedZone;
-            restoreUiState();
-            return;
-        }
-        if (Funcs::H1::moveReflectionProbes(currentSelectedZone))
-            qDebug() << "Reflection probes successfully generated";
-        restoreUiState();
-        qDebug() << "Generated reflection probes for map" << currentSelectedZone;
-        qInfo() << "Build your zone again to see the generated reflection probes";
-	});
+Task<void> H1ModTools::compileReflections(QFileInfo game, QStringList arguments, QString zone, CancellationToken token)
+{
+    auto running = runProcess(m_runner, game, arguments, token);
+    const int exitCode = co_await running;
+
+    qDebug() << game.fileName() << "finished with exit code" << exitCode;
+    reportProcessTelemetry("reflections_" + zone);
+    if (exitCode != EXIT_SUCCESS) {
+        qCritical() << "Failed to generate reflection probes for zone" << zone;
+        co_return;
+    }
+
+    auto moving = runInPool([zone]() { return Funcs::H1::moveReflectionProbes(zone); }, token);
+    if (co_await moving)
+        qDebug() << "Reflection probes successfully generated";
+
+    qDebug() << "Generated reflection probes for map" << zone;
+    qInfo() << "Build your zone again to see the generated reflection probes";
 }
 
 void H1ModTools::on_runMapButton_clicked()
@@ -743,19 +866,64 @@ void H1ModTools::on_runMapButton_clicked()
 
 void H1ModTools::onOutputBufferContextMenu(const QPoint& pos)
 {
-    QMenu* menu = ui.outputBuffer->createStandardContextMenu();
+    QMenu* menu = new QMenu(this);
+    menu->addAction(m_copyOutputAction);
     menu->addSeparator();
 
     QAction* refreshAction = menu->addAction("Clear");
-    QAction* selectedAction = menu->exec(ui.outputBuffer->mapToGlobal(pos));
+    QAction* selectedAction = menu->exec(ui.outputBuffer->viewport()->mapToGlobal(pos));
 
     if (selectedAction == refreshAction) {
-        ui.outputBuffer->clear();
+        logger->model()->clear();
     }
 
     delete menu;  // clean up
 }
 
+void H1ModTools::copyOutputSelection()
+{
+    QModelIndexList rows = ui.outputBuffer->selectionModel()->selectedRows();
+    if (rows.isEmpty())
+        return;
+
+    // selection order is click order
+    std::sort(rows.begin(), rows.end());
+
+    QStringList lines;
+    lines.reserve(rows.size());
+    for (const auto& index : rows)
+        lines << logger->model()->lineText(index.row());
+
+    QApplication::clipboard()->setText(lines.join('\n'));
+}
+
+void H1ModTools::applyLogFilter()
+{
+    quint32 levelMask = 0;
+    if (ui.logDebugCheckBox->isChecked())
+        levelMask |= logLevelBit(LogLevel::Debug);
+    if (ui.logInfoCheckBox->isChecked())
+        levelMask |= logLevelBit(LogLevel::Info);
+    if (ui.logWarningCheckBox->isChecked())
+        levelMask |= logLevelBit(LogLevel::Warning);
+    if (ui.logErrorCheckBox->isChecked())
+        levelMask |= logLevelBit(LogLevel::Critical) | logLevelBit(LogLevel::Fatal);
+
+    logger->model()->setFilter(levelMask, ui.logSearchEdit->text());
+    ui.outputBuffer->scrollToBottom();
+}
+
+void H1ModTools::updateLogLineCount()
+{
+    const LogModel* logModel = logger->model();
+    const qint64 total = logModel->totalLines();
+
+    if (logModel->isFiltered())
+        ui.logLineCountLabel->setText(QString("%1 of %2 lines").arg(logModel->rowCount()).arg(total));
+    else
+        ui.logLineCountLabel->setText(QString("%1 lines").arg(total));
+}
+
 void H1ModTools::onTreeContextMenuRequested(const QPoint& pos)
 {
     auto* tree = qobject_cast<QTreeWidget*>(sender());
@@ -907,10 +1075,89 @@ void dumpZoneToolAssets()
     // we need to check if zonetool_assets/<game> exists, if not, let's create it.
 }
 
+template <typename SourceGame>
+QTreeWidget* H1ModTools::sourceTreeWidget() const
+{
+    if constexpr (SourceGame::type == IW3)
+        return treeWidgetIW3;
+    else if constexpr (SourceGame::type == IW4)
+        return treeWidgetIW4;
+    else {
+        static_assert(SourceGame::type == IW5);
+        return treeWidgetIW5;
+    }
+}
+
 // export
 void H1ModTools::exportSelection()
 {
-    const auto gameType = getCurrentGameType();
+    // the H1 tab has nothing to export
+    if (getCurrentGameType() == H1)
+        return;
+
+    visitSourceGame(getCurrentGameType(), [this](auto traits) {
+        exportSelection<decltype(traits)>();
+    });
+}
+
+void H1ModTools::dryRunSelection()
+{
+    if (getCurrentGameType() == H1)
+        return;
+
+    visitSourceGame(getCurrentGameType(), [this](auto traits) {
+        dryRunSelection<decltype(traits)>();
+    });
+}
+
+// Converts the zone's existing dump in memory to try out rule changes, nothing gets dumped or written
+template <typename SourceGame>
+void H1ModTools::dryRunSelection()
+{
+    constexpr auto gameType = SourceGame::type;
+
+    auto* widget = sourceTreeWidget<SourceGame>();
+    if (!widget->currentItem() || !widget->currentItem()->parent())
+        return;
+
+    const QString zone = QFileInfo(widget->currentItem()->text(0)).completeBaseName();
+    const QString destFolder = Globals.pathH1 + "/zonetool/" + zone;
+
+    if (!QDir(destFolder).exists()) {
+        qWarning() << "No dump of" << zone << "to dry run in" << destFolder << ", export it first";
+        return;
+    }
+
+    GSC_Convert_Settings convertSettings{
+        .sourceGameType = gameType,
+        .dryRun = true };
+
+    // same map flags the export converts with
+    if (Funcs::H1::isMap(zone)) {
+        const bool isMpMap = Funcs::H1::isMpMap(zone);
+        const QString mapsPrefix = isMpMap ? "maps/mp" : "maps";
+        const auto mapEntsRead = MapEntsReader(QString("%1/%2/%3.d3dbsp.ents").arg(destFolder, mapsPrefix, zone));
+
+        convertSettings.hasDestructibles = !mapEntsRead.getDestructibles().empty();
+        convertSettings.hasAnimatedModels = !mapEntsRead.getAnimatedModels().empty();
+        convertSettings.isMpMap = isMpMap;
+    }
+
+    qInfo() << "Dry running GSC conversion of" << zone;
+
+    disableUiAndStoreState();
+    ConvertGSCFiles(destFolder, convertSettings, this, [this](bool) {
+        restoreUiState();
+    });
+}
+
+template <typename SourceGame>
+void H1ModTools::exportSelection()
+{
+    constexpr auto gameType = SourceGame::type;
+
+    // the export rewrites the watched scripts itself, a watcher would convert them alongside it
+    m_gscWatcher.stop();
 
     auto targetPath = Funcs::Shared::getGamePath(GameType::H1);
     if (targetPath.isEmpty() || !QDir(targetPath).exists()) {
@@ -918,20 +1165,8 @@ void H1ModTools::exportSelection()
         return;
     }
     
-    static const auto getExecutableName = [gameType]() -> QString {
-        switch (gameType)
-        {
-        case IW3: return "zonetool_iw3.exe";
-        case IW4: return "zonetool_iw4.exe";
-        case IW5: return "zonetool_iw5.exe";
-        default:
-            __debugbreak();
-            return "";
-        }
-    };
-
-    const QString executable = getExecutableName();
-    const QString pathStr = Funcs::Shared::getGamePath(gameType) + "/" + executable;
+    const QString executable = SourceGame::dumpExecutable;
+    const QString pathStr = SourceGame::gamePath() + "/" + executable;
     QFileInfo file(pathStr);
 
     if (!file.exists() || !file.isExecutable()) {
@@ -939,18 +1174,8 @@ void H1ModTools::exportSelection()
         return;
     }
 
-    const auto getCurrentTreeWidget = [this, gameType]() {
-        switch (gameType) {
-        case IW3: return treeWidgetIW3;
-        case IW4: return treeWidgetIW4;
-        case IW5: return treeWidgetIW5;
-        default:
-            return static_cast<QTreeWidget*>(nullptr);
-        }
-    };
-
-    auto* widget = getCurrentTreeWidget();
-    if (!widget || !widget->currentItem() || !widget->currentItem()->parent())
+    auto* widget = sourceTreeWidget<SourceGame>();
+    if (!widget->currentItem() || !widget->currentItem()->parent())
         return;
 
     const QString currentSelectedText = widget->currentItem()->text(0);
@@ -959,7 +1184,7 @@ void H1ModTools::exportSelection()
 
 	const QFileInfo zoneFileInfo(currentSelectedText);
     const QString zone = zoneFileInfo.completeBaseName();
-    const QString zonePath = Funcs::Shared::getGamePath(gameType) + "/zone/english";
+    const QString zonePath = SourceGame::gamePath() + "/zone/english";
 
     QString usermapPath{};
     if (isUserMap) {
@@ -967,8 +1192,8 @@ void H1ModTools::exportSelection()
     }
 
     // Add a check for map source exporting
-    if (gameType == GameType::IW3 && Funcs::IW3::isMapSource(zoneFileInfo.fileName())) {
-        if (!Funcs::Shared::zoneExistsForDump(zone, gameType)) {
+    if constexpr (SourceGame::hasMapSources) {
+        if (Funcs::IW3::isMapSource(zoneFileInfo.fileName()) && !Funcs::Shared::zoneExistsForDump(zone, gameType)) {
             qWarning() << "Map source not built yet for" << currentSelectedText;
             return;
         }
@@ -994,23 +1219,24 @@ void H1ModTools::exportSelection()
     };
 
     const auto dumpZone = [=](const QString& zone, std::function<void(bool)> completed_func) {
-        disableUiAndStoreState();
-
         QStringList arguments;
         arguments 
             << "-silent" 
             << "-dumpzone" << zone;
 
-        m_runner.run(file, arguments, [=](int exitCode) {
+        // a dump has no zone source to count, the previous dump of the zone stands in for it
+        const auto progress = beginZonetoolProgress(zone, "dump", 0);
+
+        runZonetool(file, arguments, [=](int exitCode) {
             qDebug() << executable << "finished with exit code" << exitCode;
+            endZonetoolProgress(progress, "dump", exitCode == EXIT_SUCCESS);
             if (exitCode != QProcess::NormalExit) {
                 qCritical() << "Failed to dump zone" << zone;
-                restoreUiState();
                 completed_func(false);
                 return;
             }
             
-            const QString dumpFolder = Funcs::Shared::getGamePath(gameType) + "/dump/" + zone;
+            const QString dumpFolder = SourceGame::gamePath() + "/dump/" + zone;
             const QString destFolder = Globals.pathH1 + "/zonetool/" + zone;
             QtUtils::moveDirectory(dumpFolder, destFolder);
 
@@ -1049,6 +1275,10 @@ void H1ModTools::exportSelection()
                 }
             }
 
+            GSC_Convert_Settings convertSettings{
+                .sourceGameType = gameType,
+                .minify = ui.minifyGscCheckBox->isChecked() };
+
             if (isMap)
             {
                 // Copy rawfiles
@@ -1056,138 +1286,189 @@ void H1ModTools::exportSelection()
 
                 const auto mapEntsRead = MapEntsReader(mapEntsPath);
 
-                if (ui.convertGscCheckBox->isChecked()) {
-                    // Need to re-write the whole ConvertGSCFiles function etc...
-                    ConvertGSCFiles(destFolder, { // Convert GSC files to H1 format
-                        .hasDestructibles = !mapEntsRead.getDestructibles().empty(),
-                        .hasAnimatedModels = !mapEntsRead.getAnimatedModels().empty(),
-                        .isMpMap = isMpMap });
-                }
+                convertSettings.hasDestructibles = !mapEntsRead.getDestructibles().empty();
+                convertSettings.hasAnimatedModels = !mapEntsRead.getAnimatedModels().empty();
+                convertSettings.isMpMap = isMpMap;
+            }
 
-                // Copy template files here, maybe need to change this later
-                const auto addTemplateFile = [zone](const QString& templatePath, const QString& destFolder, const QString& destFile)
+            // everything after the conversion works on the converted scripts
+            const auto finishDump = [=]() {
+                if (isMap)
                 {
-                    if (!QFile::exists(destFolder + destFile)) {
-                        QtUtils::copyFile(templatePath, destFolder + destFile);
-                        QFile::rename(destFolder + QFile(templatePath).fileName(), destFolder + destFile);
-
-                        Funcs::Shared::replaceStringInFile(destFolder + destFile, "mapname", zone);
+                    // Copy template files here, maybe need to change this later
+                    const auto addTemplateFile = [zone](const QString& templatePath, const QString& destFolder, const QString& destFile)
+                    {
+                        if (!QFile::exists(destFolder + destFile)) {
+                            QtUtils::copyFile(templatePath, destFolder + destFile);
+                            QFile::rename(destFolder + QFile(templatePath).fileName(), destFolder + destFile);
+
+                            Funcs::Shared::replaceStringInFile(destFolder + destFile, "mapname", zone);
+
+                            return true;
+                        }
+                        return false;
+                    };
+
+                    addTemplateFile("static/templates/vision.vision", destFolder + "/vision/", zone + ".vision");
+                    addTemplateFile("static/templates/_art.gsc", destFolder + "/maps/createart/", zone + "_art.gsc");
+                    addTemplateFile("static/templates/_fog.gsc", destFolder + "/maps/createart/", zone + "_fog.gsc");
+                    addTemplateFile("static/templates/_fog_hdr.gsc", destFolder + "/maps/createart/", zone + "_fog_hdr.gsc");
+                    addTemplateFile("static/templates/_lightsets.csv", destFolder + "/maps/createart/", zone + "_lightsets.csv");
+                    addTemplateFile("static/templates/_lightsets_hdr.csv", destFolder + "/maps/createart/", zone + "_lightsets_hdr.csv");
+
+                    if (!isMpMap)
+                    {
+                        Funcs::Shared::replaceStringInFile(destFolder + "/maps/createart/" + zone + "_fog.gsc", "maps\\mp\\_art::create_vision_set_fog", "maps\\_utility::create_vision_set_fog");
+                        Funcs::Shared::replaceStringInFile(destFolder + "/maps/createart/" + zone + "_fog_hdr.gsc", "maps\\mp\\_art::create_vision_set_fog", "maps\\_utility::create_vision_set_fog");
+                    }
 
-                        return true;
+                    // copy waypoint files if they exist
+                    QStringList waypointPaths = {
+                        QString("static/waypoints/%1_wp.csv").arg(zone),
+                        QString("static/waypoints/%1.csv").arg(zone)
+                    };
+
+                    for (const QString& path : waypointPaths) {
+                        if (QFile::exists(path)) {
+                            QFile::copy(path, destFolder + "/" + mapsPrefix + "/" + QFileInfo(path).fileName());
+                            break;
+                        }
                     }
-                    return false;
-                };
 
-                addTemplateFile("static/templates/vision.vision", destFolder + "/vision/", zone + ".vision");
-                addTemplateFile("static/templates/_art.gsc", destFolder + "/maps/createart/", zone + "_art.gsc");
-                addTemplateFile("static/templates/_fog.gsc", destFolder + "/maps/createart/", zone + "_fog.gsc");
-                addTemplateFile("static/templates/_fog_hdr.gsc", destFolder + "/maps/createart/", zone + "_fog_hdr.gsc");
-                addTemplateFile("static/templates/_lightsets.csv", destFolder + "/maps/createart/", zone + "_lightsets.csv");
-                addTemplateFile("static/templates/_lightsets_hdr.csv", destFolder + "/maps/createart/", zone + "_lightsets_hdr.csv");
+                    // load <map>.iwd and dump images and sounds folder to destFolder
+                    // we need to load dumped csv and get all the image references and try to get them from the raw/images folder
 
-                if (!isMpMap)
-                {
-                    Funcs::Shared::replaceStringInFile(destFolder + "/maps/createart/" + zone + "_fog.gsc", "maps\\mp\\_art::create_vision_set_fog", "maps\\_utility::create_vision_set_fog");
-                    Funcs::Shared::replaceStringInFile(destFolder + "/maps/createart/" + zone + "_fog_hdr.gsc", "maps\\mp\\_art::create_vision_set_fog", "maps\\_utility::create_vision_set_fog");
+                    //convertMp3ToFlacForFolder(destFolder + "/sound");
+                    // move converted sounds to loaded_sound
                 }
 
-                // copy waypoint files if they exist
-                QStringList waypointPaths = {
-                    QString("static/waypoints/%1_wp.csv").arg(zone),
-                    QString("static/waypoints/%1.csv").arg(zone)
-                };
-
-                for (const QString& path : waypointPaths) {
-                    if (QFile::exists(path)) {
-                        QFile::copy(path, destFolder + "/" + mapsPrefix + "/" + QFileInfo(path).fileName());
-                        break;
-                    }
+                if (isMapLoad) {
+                    QtUtils::copyFile(destFolder + "/materials/$levelbriefing.json", destFolder + "/materials/$levelbriefingcrossfade.json");
                 }
 
-                // load <map>.iwd and dump images and sounds folder to destFolder
-                // we need to load dumped csv and get all the image references and try to get them from the raw/images folder
+                if (ui.generateCsvCheckBox->isChecked()) {
+                    generateCSV(zone, destFolder, isMpMap, gameType, GameType::H1, ui.pruneGscCheckBox->isChecked());
+                }
 
-                //convertMp3ToFlacForFolder(destFolder + "/sound");
-                // move converted sounds to loaded_sound
-            }
-            else {
-                if (ui.convertGscCheckBox->isChecked()) {
-                    ConvertGSCFiles(destFolder, {}); // Convert GSC files to H1 format
+                // keep converting scripts as they are edited, only new scripts change the csv.
+                // load zones dump alongside their map, the watcher follows the map
+                if (ui.watchGscCheckBox->isChecked() && ui.convertGscCheckBox->isChecked() && !isMapLoad) {
+                    // the user edits these scripts, so saves get converted but never minified
+                    GSC_Convert_Settings watchSettings = convertSettings;
+                    watchSettings.minify = false;
+                    watchSettings.dryRun = false;
+
+                    m_gscWatcher.start(destFolder, watchSettings, [this, zone, destFolder, isMpMap, gameType]() {
+                        if (ui.generateCsvCheckBox->isChecked())
+                            generateCSV(zone, destFolder, isMpMap, gameType, GameType::H1, ui.pruneGscCheckBox->isChecked());
+                    });
                 }
-            }
 
-            if (isMapLoad) {
-                QtUtils::copyFile(destFolder + "/materials/$levelbriefing.json", destFolder + "/materials/$levelbriefingcrossfade.json");
-            }
+                completed_func(true);
+            };
 
-            if (ui.generateCsvCheckBox->isChecked()) {
-                generateCSV(zone, destFolder, isMpMap, gameType, GameType::H1);
+            if (!ui.convertGscCheckBox->isChecked()) {
+                finishDump();
+                return;
             }
 
-            restoreUiState();
+            // the other zone of the export keeps dumping while this one converts
+            ConvertGSCFiles(destFolder, convertSettings, this, [=](bool converted) {
+                if (!converted) {
+                    qCritical() << "Failed to convert the GSC files of" << zone;
+                    completed_func(false);
+                    return;
+                }
 
-            completed_func(true);
-		});
+                finishDump();
+            });
+		}, zonetoolLineHandler(progress));
     };
 
     dumpZoneToolAssets();
     // we need to also dump techset zones to zonetool_paths if it's not already done...
 
-    if (isUserMap) {
-        const QString zone_ff_path = zonePath + "/" + zone + ".ff";
-        const QString usermap_ff_path = usermapPath + "/" + zone + ".ff";
-        bool cleanAfter = (QFile(zone_ff_path).exists() == false);
-        QtUtils::copyFile(usermap_ff_path, zone_ff_path);
-
-        const auto completed_func = [=](bool success) {
-            if (cleanAfter) {
-                QtUtils::deleteFile(zone_ff_path);
+    // zones dump independently of each other, the map and its load zone run side by side
+    auto* graph = new JobGraph(m_runner, this);
+
+    // usermaps are copied next to the stock zones while they get dumped
+    const auto addDumpJob = [=](const QString& zone, const QString& usermapFFPath) {
+        return graph->add("dump " + zone, [=](std::function<void(bool)> done) {
+            const QString zone_ff_path = zonePath + "/" + zone + ".ff";
+            bool cleanAfter = false;
+            if (!usermapFFPath.isEmpty()) {
+                cleanAfter = (QFile(zone_ff_path).exists() == false);
+                QtUtils::copyFile(usermapFFPath, zone_ff_path);
             }
-            if (success)
-            {
-                // dump map load zone
-                {
-                    const QString zone_load = zone + "_load";
-                    const QString zone_loadff_path = zonePath + "/" + zone_load + ".ff";
-                    const QString usermap_loadff_path = usermapPath + "/" + zone_load + ".ff";
 
-                    if (QFile(usermap_loadff_path).exists()) {
-                        bool cleanAfter = (QFile(zone_loadff_path).exists() == false);
-                        QtUtils::copyFile(usermap_loadff_path, zone_loadff_path);
+            dumpZone(zone, [=](bool success) {
+                if (cleanAfter) {
+                    QtUtils::deleteFile(zone_ff_path);
+                }
+                done(success);
+            });
+        });
+    };
 
-                        const auto completed_func2 = [=](bool success) {
-                            if (cleanAfter) {
-                                QtUtils::deleteFile(zone_loadff_path);
-                            }
+    // dump map zone
+    const auto mapDump = addDumpJob(zone, isUserMap ? usermapPath + "/" + zone + ".ff" : QString());
 
-                            showH1WidgetForZone(zone);
-                        };
+    // dump map load zone
+    if (isUserMap) {
+        const QString zone_load = zone + "_load";
+        const QString usermap_loadff_path = usermapPath + "/" + zone_load + ".ff";
+        if (QFile(usermap_loadff_path).exists()) {
+            addDumpJob(zone_load, usermap_loadff_path);
+        }
+    }
 
-                        dumpZone(zone_load, completed_func2);
-                    }
-                    else {
-                        showH1WidgetForZone(zone);
-                    }
-                }
-            }
-        };
+    disableUiAndStoreState();
+    m_runner.telemetry().reset();
 
-        // dump map zone
-        dumpZone(zone, completed_func);
-    }
-    else {
-        const auto completed_func = [=](bool success) {
+    graph->run([=](bool) {
+        reportProcessTelemetry("export_" + zone);
+        restoreUiState();
+        if (graph->succeeded(mapDump)) {
+            showH1WidgetForZone(zone);
+        }
+        graph->deleteLater();
+    });
+}
+
+// Runs exe unless the build cache holds outputs for the same tool, arguments and inputs
+JobGraph::JobId H1ModTools::addCachedProcess(
+    JobGraph& graph,
+    std::shared_ptr<BuildCache> cache,
+    const QString& name,
+    const QFileInfo& exe,
+    const QStringList& args,
+    const CachedStepFiles& files,
+    const QList<JobGraph::JobId>& dependencies,
+    std::function<bool(int)> onExit)
+{
+    if (!cache)
+        return graph.addProcess(name, exe, args, dependencies, onExit);
+
+    return graph.add(name, [this, cache, name, exe, args, files, onExit](std::function<void(bool)> done) {
+        // inputs can come from the steps before, key the step once they are done
+        const QString key = cache->key(exe, args, files.inputs, files.inputTrees);
+        if (cache->restore(key)) {
+            qDebug() << "Restored" << name << "from the build cache";
+            done(true);
+            return;
+        }
+
+        m_runner.run(exe, args, [cache, key, files, onExit, done](int exitCode) {
+            const bool success = onExit ? onExit(exitCode) : exitCode == EXIT_SUCCESS;
             if (success)
-            {
-                showH1WidgetForZone(zone);
-            }
-        };
-        dumpZone(zone, completed_func);
-    }
+                cache->store(key, files.outputs);
+            done(success);
+        });
+    }, dependencies);
 }
 
 // used for IW3 map source building inside H1 mod tools
-void H1ModTools::buildIW3MapFastfile(const QString& mapName, const QString& cod4Dir)
+JobGraph::JobId H1ModTools::buildIW3MapFastfile(JobGraph& graph, std::shared_ptr<BuildCache> cache, const QString& mapName, const QString& cod4Dir, JobGraph::JobId after)
 {
     const auto linkerPath = cod4Dir + "/bin/linker_pc.exe";
     const auto zoneSourceDir = cod4Dir + "/zone_source";
@@ -1197,16 +1478,14 @@ void H1ModTools::buildIW3MapFastfile(const QString& mapName, const QString& cod4
 
     if (!linkerFile.exists()) {
         qCritical() << "Missing linker_pc.exe at" << linkerPath;
-        restoreUiState();
-        return;
+        return -1;
     }
 
     const auto hasMapCsv = QFile::exists(zoneSourceDir + "/" + mapName + ".csv");
     if (!hasMapCsv)
     {
         qCritical() << "Failed to find map CSV for map" << mapName;
-        restoreUiState();
-        return;
+        return -1;
     }
 
     const auto hasLoadCsv = QFile::exists(zoneSourceDir + "/" + mapName + "_load.csv");
@@ -1224,28 +1503,39 @@ void H1ModTools::buildIW3MapFastfile(const QString& mapName, const QString& cod4
         qWarning() << "Failed to find load CSV for map" << mapName;
     }
 
-    qDebug() << "Building fastfiles for" << fastfiles.join(", ");
-
     QStringList args = {
         "-language", "english"
     };
     args += fastfiles;
 
-    m_runner.run(linkerFile, args, [=](int exitCode) {
+    const auto announce = graph.addTask("announce fastfiles", [=]() {
+        qDebug() << "Building fastfiles for" << fastfiles.join(", ");
+        return true;
+    }, { after });
+
+    // the linker pulls from all of raw/, that tree is fingerprinted rather than hashed
+    CachedStepFiles files;
+    files.inputTrees << cod4Dir + "/raw";
+    for (const QString& fastfile : fastfiles) {
+        files.inputs << zoneSourceDir + "/" + fastfile + ".csv";
+        files.outputs << zoneDir + "/english/" + fastfile + ".ff";
+    }
+
+    return addCachedProcess(graph, cache, "linker_pc " + mapName, linkerFile, args, files, { announce }, [=](int exitCode) {
         if (exitCode != EXIT_SUCCESS) {
             qCritical() << "Fastfile build failed for" << mapName;
-            restoreUiState();
-            return;
+            return false;
         }
 
         qDebug() << "Fastfiles built successfully for" << mapName;
-        restoreUiState();
+        return true;
 	});
 }
 
-void H1ModTools::compileIW3MapReflections(const QString& mapName, const QString& cod4Dir)
+JobGraph::JobId H1ModTools::compileIW3MapReflections(JobGraph& graph, std::shared_ptr<BuildCache> cache, const QString& mapName, const QString& cod4Dir, JobGraph::JobId after)
 {
     const auto isMP = mapName.startsWith("mp_");
+    const auto bspFile = cod4Dir + "/raw/maps" + (isMP ? "/mp/" : "/") + mapName + ".d3dbsp";
     const auto toolExe = isMP ? "mp_tool.exe" : "sp_tool.exe";
     const auto toolPath = cod4Dir + "/" + toolExe;
 
@@ -1253,14 +1543,12 @@ void H1ModTools::compileIW3MapReflections(const QString& mapName, const QString&
 
     if (!toolFile.exists()) {
         qCritical() << "Missing executable:" << toolPath;
-        restoreUiState();
-        return;
+        return -1;
     }
 
     if (!ui.compileReflectionsCheckBox->isChecked())
     {
-        buildIW3MapFastfile(mapName, cod4Dir);
-        return;
+        return after;
     }
 
     QStringList args = {
@@ -1284,22 +1572,27 @@ void H1ModTools::compileIW3MapReflections(const QString& mapName, const QString&
         "+devmap", mapName
     };
 
-    qDebug() << "Launching" << toolExe << "to generate reflections for" << mapName;
+    const auto announce = graph.addTask("announce reflections", [=]() {
+        qDebug() << "Launching" << toolExe << "to generate reflections for" << mapName;
+        return true;
+    }, { after });
+
+    // probes are baked into the bsp
+    CachedStepFiles files;
+    files.inputs << bspFile;
+    files.outputs << bspFile;
 
-    m_runner.run(toolFile, args, [=](int exitCode) {
+    return addCachedProcess(graph, cache, QString(toolExe) + " reflections " + mapName, toolFile, args, files, { announce }, [=](int exitCode) {
         if (exitCode != EXIT_SUCCESS) {
             qCritical() << "Reflection generation failed for" << mapName;
-            restoreUiState();
-            return;
+            return false;
         }
         qDebug() << "Reflection probe generation complete for" << mapName;
-
-        // finally, build the IW3 fastfile
-        buildIW3MapFastfile(mapName, cod4Dir);
+        return true;
     });
 }
 
-void H1ModTools::compileIW3Map(const QString& mapName, const QString& cod4Dir, const QString& lightOptions)
+JobGraph::JobId H1ModTools::compileIW3Map(JobGraph& graph, std::shared_ptr<BuildCache> cache, const QString& mapName, const QString& cod4Dir, const QString& lightOptions)
 {
     const auto bsppath = cod4Dir + "/raw/maps" + (mapName.startsWith("mp_") ? "/mp" : "");
     const auto mapSourcePath = cod4Dir + "/map_source";
@@ -1315,35 +1608,54 @@ void H1ModTools::compileIW3Map(const QString& mapName, const QString& cod4Dir, c
 
     if (!cod4mapFile.exists() || !cod4radFile.exists()) {
         qCritical() << "Missing cod4map or cod4rad.";
-        restoreUiState();
-        return;
-    }
-
-    if (!QDir().mkpath(bsppath)) {
-        qCritical() << "Couldn't create path:" << bsppath;
-        restoreUiState();
-        return;
+        return -1;
     }
 
-    // ---- copy source map to bsp path temporarily 
     const auto srcMap = mapSourcePath + "/" + mapName + ".map";
     const auto dstMap = bsppath + "/" + mapName + ".map";
-    QFile::remove(dstMap); // overwrite
-    QFile::copy(srcMap, dstMap);
 
-    // ---- compile BSP
-    qDebug() << "Compiling BSP...";
+    // ---- copy source map to bsp path temporarily 
+    const auto copyMap = graph.addTask("copy " + mapName + ".map", [=]() {
+        if (!QDir().mkpath(bsppath)) {
+            qCritical() << "Couldn't create path:" << bsppath;
+            return false;
+        }
+
+        QFile::remove(dstMap); // overwrite
+        QFile::copy(srcMap, dstMap);
 
+        qDebug() << "Compiling BSP...";
+        return true;
+    });
+
+    // ---- compile BSP
     const auto args = QStringList{ "-platform", "pc", "-loadFrom", srcMap, dstMap }; // TODO: add bsp options later
 
-    m_runner.run(cod4mapFile, args, [=](int exitCode) {
+    const auto bspBase = bsppath + "/" + mapName;
+
+    // both tools resolve materials, their images and misc_models through raw/. Not all of raw/,
+    // the copied .map in raw/maps would change the key on every run
+    QStringList assetTrees;
+    for (const char* folder : { "materials", "material_properties", "images", "xmodel", "xmodelparts", "xmodelsurfs" })
+        assetTrees << cod4Dir + "/raw/" + folder;
+
+    CachedStepFiles bspFiles;
+    bspFiles.inputs << srcMap;
+    bspFiles.inputTrees << mapSourcePath + "/prefabs" << assetTrees;
+    bspFiles.outputs << bspBase + ".d3dbsp" << bspBase + ".d3dprt" << bspBase + ".d3dpoly" << bspBase + ".lin";
+
+    const auto bsp = addCachedProcess(graph, cache, "cod4map " + mapName, cod4mapFile, args, bspFiles, { copyMap }, [=](int exitCode) {
         if (exitCode != EXIT_SUCCESS) {
             qCritical() << "BSP compile failed for" << mapName;
-            restoreUiState();
-            return;
+            return false;
         }
 
-        // ---- compile light
+        qDebug() << "BSP compiled successfully for" << mapName;
+        return true;
+    });
+
+    // ---- compile light
+    const auto copyGrid = graph.addTask("copy " + mapName + ".grid", [=]() {
         qDebug() << "Compiling lighting...";
         const auto srcGrid = mapSourcePath + "/" + mapName + ".grid";
         const auto dstGrid = bsppath + "/" + mapName + ".grid";
@@ -1351,43 +1663,223 @@ void H1ModTools::compileIW3Map(const QString& mapName, const QString& cod4Dir, c
             QFile::remove(dstGrid);
             QFile::copy(srcGrid, dstGrid);
         }
+        return true;
+    }, { bsp });
 
-        QStringList radArgs{ "-platform", "pc" };
-        if (!lightOptions.trimmed().isEmpty())
-            radArgs.append(lightOptions.trimmed().split(' '));
-        radArgs << bsppath + "/" + mapName;
+    QStringList radArgs{ "-platform", "pc" };
+    if (!lightOptions.trimmed().isEmpty())
+        radArgs.append(lightOptions.trimmed().split(' '));
+    radArgs << bsppath + "/" + mapName;
 
-        m_runner.run(cod4radFile, radArgs, [=](int exitCode) {
-            if (exitCode != EXIT_SUCCESS) {
-                qCritical() << "Lighting compile failed for" << mapName;
-                restoreUiState();
-                return;
-            }
+    // light is baked into the bsp cod4map wrote
+    CachedStepFiles lightFiles;
+    lightFiles.inputs << bspBase + ".d3dbsp" << bspBase + ".grid";
+    lightFiles.inputTrees << assetTrees;
+    lightFiles.outputs << bspBase + ".d3dbsp";
 
-            // ---- cleanup
-            for (const QString& ext : { ".map", ".d3dprt", ".d3dpoly", ".vclog", ".grid" })
-                QFile::remove(bsppath + "/" + mapName + ext);
+    const auto light = addCachedProcess(graph, cache, "cod4rad " + mapName, cod4radFile, radArgs, lightFiles, { copyGrid }, [=](int exitCode) {
+        if (exitCode != EXIT_SUCCESS) {
+            qCritical() << "Lighting compile failed for" << mapName;
+            return false;
+        }
+        return true;
+    });
 
-            // ----move .lin if exists
-            const QString linSrc = bsppath + "/" + mapName + ".lin";
-            const QString linDst = mapSourcePath + "/" + mapName + ".lin";
-            if (QFile::exists(linSrc)) {
-                QFile::remove(linDst);
-                QFile::rename(linSrc, linDst);
-            }
+    return graph.addTask("clean up " + mapName + " compile", [=]() {
+        // ---- cleanup
+        for (const QString& ext : { ".map", ".d3dprt", ".d3dpoly", ".vclog", ".grid" })
+            QFile::remove(bsppath + "/" + mapName + ext);
+
+        // ----move .lin if exists
+        const QString linSrc = bsppath + "/" + mapName + ".lin";
+        const QString linDst = mapSourcePath + "/" + mapName + ".lin";
+        if (QFile::exists(linSrc)) {
+            QFile::remove(linDst);
+            QFile::rename(linSrc, linDst);
+        }
 
-            // TODO: connect paths later with sp tool?
+        // TODO: connect paths later with sp tool?
 
-            qDebug() << mapName << "has been compiled for IW3";
+        qDebug() << mapName << "has been compiled for IW3";
+        return true;
+    }, { light });
+}
 
-            // now, we need to generate the reflections for the map
-            compileIW3MapReflections(mapName, cod4Dir);
-        });
+void H1ModTools::runZonetool(const QFileInfo& exe, const QStringList& args, std::function<void(int)> onFinish, ProcessRunner::LineHandler onLine)
+{
+    // a worker keeps the common zones loaded between builds, only tools that support -worker can be one
+    if (QSettings().value("KeepZonetoolRunning", false).toBool())
+        m_runner.runInWorker(exe, args, std::move(onFinish), std::move(onLine));
+    else
+        m_runner.run(exe, args, std::move(onFinish), std::move(onLine));
+}
 
-        qDebug() << "BSP compiled successfully for" << mapName;
+Task<int> H1ModTools::runZonetool(QFileInfo exe, QStringList args, ProcessRunner::LineHandler onLine, CancellationToken token)
+{
+    if (!QSettings().value("KeepZonetoolRunning", false).toBool()) {
+        auto running = runProcess(m_runner, exe, args, token, onLine);
+        co_return co_await running;
+    }
+
+    // a worker serves other runs too, cancelling waits for the command instead of killing it
+    auto running = fromCallback<int>([&](std::function<void(int)> done) {
+        m_runner.runInWorker(exe, args, std::move(done), std::move(onLine));
+    }, token);
+    co_return co_await running;
+}
+
+void H1ModTools::startPipeline(const QString& name, std::function<Task<void>(CancellationToken)> pipeline)
+{
+    disableUiAndStoreState();
+    m_runner.telemetry().reset();
+
+    m_pipelineCancel = std::make_shared<CancellationSource>();
+    ui.cancelButton->setEnabled(true);
+    ui.cancelButton->show();
+
+    // however the pipeline ends, the ui comes back
+    pipeline(m_pipelineCancel->token()).start([this, name](std::exception_ptr error) {
+        try {
+            if (error)
+                std::rethrow_exception(error);
+        }
+        catch (const TaskCancelled&) {
+            qWarning().noquote() << name << "was cancelled";
+        }
+        catch (const std::exception& e) {
+            qCritical().noquote() << name << "failed:" << e.what();
+        }
+
+        m_pipelineCancel.reset();
+        ui.cancelButton->hide();
+        restoreUiState();
     });
 }
 
+void H1ModTools::on_cancelButton_clicked()
+{
+    if (!m_pipelineCancel)
+        return;
+
+    qInfo() << "Cancelling...";
+    ui.cancelButton->setEnabled(false);
+    m_pipelineCancel->cancel();
+}
+
+static QString assetCountsPath(const QString& zone, const QString& mode)
+{
+    return QString("telemetry/assets/%1_%2.json").arg(zone, mode);
+}
+
+std::shared_ptr<ZonetoolProgress> H1ModTools::beginZonetoolProgress(const QString& zone, const QString& mode, int expectedAssets)
+{
+    if (expectedAssets <= 0) {
+        expectedAssets = 0;
+        for (const int count : ZonetoolProgress::loadCounts(assetCountsPath(zone, mode)))
+            expectedAssets += count;
+    }
+
+    auto progress = std::make_shared<ZonetoolProgress>(zone, expectedAssets);
+    m_zonetoolProgress << progress;
+
+    ui.zonetoolProgressBar->show();
+    updateZonetoolProgressBar();
+    return progress;
+}
+
+ProcessRunner::LineHandler H1ModTools::zonetoolLineHandler(std::shared_ptr<ZonetoolProgress> progress)
+{
+    return [this, progress](QByteArrayView line, qint64) {
+        // zonetool prints thousands of lines, a few repaints a second are plenty
+        if (progress->feed(line) && (!m_zonetoolProgressRefresh.isValid() || m_zonetoolProgressRefresh.elapsed() >= 100))
+            updateZonetoolProgressBar();
+    };
+}
+
+void H1ModTools::endZonetoolProgress(std::shared_ptr<ZonetoolProgress> progress, const QString& mode, bool success)
+{
+    m_zonetoolProgress.removeOne(progress);
+
+    // failed runs stop early, their counts would make the next comparison meaningless
+    if (success && !progress->countsByType().isEmpty()) {
+        const QString countsPath = assetCountsPath(progress->zone(), mode);
+        progress->logCountChanges(ZonetoolProgress::loadCounts(countsPath));
+        progress->saveCounts(countsPath);
+    }
+
+    if (m_zonetoolProgress.isEmpty())
+        ui.zonetoolProgressBar->hide();
+    else
+        updateZonetoolProgressBar();
+}
+
+void H1ModTools::updateZonetoolProgressBar()
+{
+    m_zonetoolProgressRefresh.start();
+
+    // parallel dumps share the bar, it fills once all of them are done
+    int done = 0;
+    int expected = 0;
+    bool expectedKnown = true;
+    double assetsPerSecond = 0.0;
+    double megabytesPerSecond = 0.0;
+    qint64 etaSeconds = 0;
+
+    for (const auto& progress : m_zonetoolProgress) {
+        const auto snapshot = progress->snapshot();
+        done += std::max(snapshot.loaded, snapshot.written);
+        expected += snapshot.expected;
+        expectedKnown = expectedKnown && snapshot.expected > 0 && snapshot.etaSeconds >= 0;
+        assetsPerSecond += snapshot.assetsPerSecond;
+        megabytesPerSecond += snapshot.megabytesPerSecond;
+        etaSeconds = std::max(etaSeconds, snapshot.etaSeconds);
+    }
+
+    QString rates = QString("%1 assets/s").arg(assetsPerSecond, 0, 'f', 0);
+    if (megabytesPerSecond > 0.0)
+        rates += QString(" - %1 MB/s").arg(megabytesPerSecond, 0, 'f', 1);
+
+    if (expectedKnown && expected > 0) {
+        ui.zonetoolProgressBar->setRange(0, expected);
+        ui.zonetoolProgressBar->setValue(std::min(done, expected));
+        ui.zonetoolProgressBar->setFormat(QString("%1 / %2 assets - %3 - ETA %4:%5")
+            .arg(done).arg(expected).arg(rates)
+            .arg(etaSeconds / 60).arg(etaSeconds % 60, 2, 10, QChar('0')));
+    }
+    else {
+        // no idea how many assets are coming, keep the bar busy
+        ui.zonetoolProgressBar->setRange(0, 0);
+        ui.zonetoolProgressBar->setFormat(QString("%1 assets - %2").arg(done).arg(rates));
+    }
+}
+
+void H1ModTools::reportZonetoolHotspots(ZonetoolHotspots& hotspots, const QString& zone)
+{
+    constexpr int reportedCount = 20;
+
+    hotspots.finish(m_runner.elapsedUs());
+    hotspots.logReport(zone, reportedCount);
+
+    // one report per build next to the zone's csv, earlier builds stay around to compare against
+    const QString reportPath = QString("%1/zone_source/hotspots/%2_%3.json")
+        .arg(Globals.pathH1, zone, QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+    if (hotspots.totalUs() > 0 && hotspots.saveReport(reportPath, zone, reportedCount))
+        qDebug() << "Hotspot report written to" << reportPath;
+}
+
+void H1ModTools::reportProcessTelemetry(const QString& pipeline)
+{
+    const auto& telemetry = m_runner.telemetry();
+    if (telemetry.samples().isEmpty())
+        return;
+
+    telemetry.logSummary("Processes run for " + pipeline + ":");
+
+    const QString tracePath = QString("telemetry/%1_%2.json").arg(pipeline, QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+    if (telemetry.writeChromeTrace(tracePath))
+        qDebug() << "Process trace written to" << QFileInfo(tracePath).absoluteFilePath();
+}
+
 // ui state
 void H1ModTools::updateMapButtonStates(const bool is_visible, const bool is_disabled)
 {
@@ -1397,7 +1889,8 @@ void H1ModTools::updateMapButtonStates(const bool is_visible, const bool is_disa
         ui.extraCheckBox,
         ui.verboseCheckBox,
         ui.modelShadowCheckBox,
-        ui.compileReflectionsCheckBox
+        ui.compileReflectionsCheckBox,
+        ui.buildCacheCheckBox
     };
 
     for (auto* widget : map_build_widgets)
@@ -1412,7 +1905,11 @@ void H1ModTools::updateExportButtonStates(const bool is_visible, const bool is_d
     static const QList<QWidget*> map_build_widgets = {
         ui.exportButton,
         ui.generateCsvCheckBox,
-        ui.convertGscCheckBox
+        ui.convertGscCheckBox,
+        ui.dryRunGscButton,
+        ui.minifyGscCheckBox,
+        ui.pruneGscCheckBox,
+        ui.watchGscCheckBox
     };
 
     for (auto* widget : map_build_widgets)
@@ -1436,12 +1933,17 @@ void H1ModTools::disableUiAndStoreState() {
         ui.developerCheckBox,
         ui.generateCsvCheckBox,
         ui.convertGscCheckBox,
+        ui.dryRunGscButton,
+        ui.minifyGscCheckBox,
+        ui.pruneGscCheckBox,
+        ui.watchGscCheckBox,
         ui.buildAndExportButton,
         ui.fastCheckBox,
         ui.extraCheckBox,
         ui.verboseCheckBox,
         ui.modelShadowCheckBox,
-        ui.compileReflectionsCheckBox
+        ui.compileReflectionsCheckBox,
+        ui.buildCacheCheckBox
     };
 
     m_uiEnabledStates.clear();
@@ -5,6 +5,13 @@
 
 #include "LogRedirector.h"
 #include "ProcessRunner.h"
+#include "JobGraph.h"
+#include "Task.h"
+#include "ZonetoolProgress.h"
+#include "ZonetoolHotspots.h"
+
+#include "Utils/BuildCache.h"
+#include "GSCWatcher.h"
 
 class H1ModTools : public QMainWindow
 {
@@ -29,31 +36,93 @@ private:
 
 private slots:
     void on_exportButton_clicked();
+    void on_dryRunGscButton_clicked();
     void on_buildAndExportButton_clicked();
 
     void on_runMapButton_clicked();
     void on_compileReflectionsButton_clicked();
     void on_buildZoneButton_clicked();
+    void on_cancelButton_clicked();
     void on_settingsButton_clicked();
     void onTreeContextMenuRequested(const QPoint& pos);
     void onOutputBufferContextMenu(const QPoint& pos);
+    void copyOutputSelection();
+    void applyLogFilter();
+    void updateLogLineCount();
 
 private:
     Ui::H1ModToolsClass ui;
     std::unique_ptr<LogRedirector> logger;
+    QAction* m_copyOutputAction = nullptr;
 
 	ProcessRunner m_runner;
+    GSCWatcher m_gscWatcher;
 
     QTreeWidget* treeWidgetH1 = nullptr;
     QTreeWidget* treeWidgetIW3 = nullptr;
     QTreeWidget* treeWidgetIW4 = nullptr;
     QTreeWidget* treeWidgetIW5 = nullptr;
 
+    // The tab listing SourceGame's zones
+    template <typename SourceGame>
+    QTreeWidget* sourceTreeWidget() const;
+
+    void exportSelection();
+    template <typename SourceGame>
     void exportSelection();
+    void dryRunSelection();
+    template <typename SourceGame>
+    void dryRunSelection();
     
-    void buildIW3MapFastfile(const QString& mapName, const QString& cod4Dir);
-    void compileIW3MapReflections(const QString& mapName, const QString& cod4Dir);
-    void compileIW3Map(const QString& mapName, const QString& cod4Dir, const QString& lightOptions);
+    struct CachedStepFiles
+    {
+        QStringList inputs;     // hashed by content
+        QStringList inputTrees; // fingerprinted by file size and time
+        QStringList outputs;
+    };
+
+    JobGraph::JobId addCachedProcess(
+        JobGraph& graph,
+        std::shared_ptr<BuildCache> cache,
+        const QString& name,
+        const QFileInfo& exe,
+        const QStringList& args,
+        const CachedStepFiles& files,
+        const QList<JobGraph::JobId>& dependencies,
+        std::function<bool(int)> onExit);
+
+    // each adds its steps to graph after the given job and returns the last one, -1 when it can't run.
+    // cache may be null, the steps then always run
+    JobGraph::JobId buildIW3MapFastfile(JobGraph& graph, std::shared_ptr<BuildCache> cache, const QString& mapName, const QString& cod4Dir, JobGraph::JobId after);
+    JobGraph::JobId compileIW3MapReflections(JobGraph& graph, std::shared_ptr<BuildCache> cache, const QString& mapName, const QString& cod4Dir, JobGraph::JobId after);
+    JobGraph::JobId compileIW3Map(JobGraph& graph, std::shared_ptr<BuildCache> cache, const QString& mapName, const QString& cod4Dir, const QString& lightOptions);
+
+    // runs zonetool in a worker that stays around between runs when the settings ask for it
+    void runZonetool(const QFileInfo& exe, const QStringList& args, std::function<void(int)> onFinish, ProcessRunner::LineHandler onLine = {});
+    Task<int> runZonetool(QFileInfo exe, QStringList args, ProcessRunner::LineHandler onLine, CancellationToken token);
+
+    // Runs pipeline with the ui disabled and the cancel button up, both come back however it ends
+    void startPipeline(const QString& name, std::function<Task<void>(CancellationToken)> pipeline);
+    std::shared_ptr<CancellationSource> m_pipelineCancel;
+
+    Task<void> buildZone(QFileInfo zonetool, QString zone, CancellationToken token);
+    Task<void> compileReflections(QFileInfo game, QStringList arguments, QString zone, CancellationToken token);
+
+    // zonetool runs feed the progress bar under the log while they're going,
+    // mode keeps dump and build asset counts apart between runs
+    std::shared_ptr<ZonetoolProgress> beginZonetoolProgress(const QString& zone, const QString& mode, int expectedAssets);
+    ProcessRunner::LineHandler zonetoolLineHandler(std::shared_ptr<ZonetoolProgress> progress);
+    void endZonetoolProgress(std::shared_ptr<ZonetoolProgress> progress, const QString& mode, bool success);
+    void updateZonetoolProgressBar();
+
+    QList<std::shared_ptr<ZonetoolProgress>> m_zonetoolProgress;
+    QElapsedTimer m_zonetoolProgressRefresh;
+
+    // logs and saves the assets a zone build spent the most time on
+    void reportZonetoolHotspots(ZonetoolHotspots& hotspots, const QString& zone);
+
+    // logs how long each process of the pipeline took and writes a chrome trace of it to telemetry/
+    void reportProcessTelemetry(const QString& pipeline);
 
     QMap<QWidget*, bool> m_uiEnabledStates;
     void updateMapButtonStates(const bool is_visible, const bool is_disabled);
@@ -0,0 +1,161 @@
+#include "JobGraph.h"
+
+JobGraph::JobGraph(ProcessRunner& runner, QObject* parent)
+    : QObject(parent), m_runner(runner), m_maxConcurrency(std::max(1, QThread::idealThreadCount()))
+{
+}
+
+JobGraph::JobId JobGraph::add(const QString& name, Job job, const QList<JobId>& dependencies)
+{
+    Q_ASSERT(!m_running);
+
+    const JobId id = static_cast<JobId>(m_nodes.size());
+
+    // dependencies always come first, so the graph can't have cycles
+    for (const JobId dependency : dependencies)
+    {
+        Q_ASSERT(dependency >= 0 && dependency < id);
+        m_nodes[dependency].dependents << id;
+    }
+
+    m_nodes.push_back({ name, std::move(job), dependencies });
+    return id;
+}
+
+JobGraph::JobId JobGraph::addProcess(
+    const QString& name,
+    const QFileInfo& exe,
+    const QStringList& args,
+    const QList<JobId>& dependencies,
+    std::function<bool(int)> onExit)
+{
+    return add(name, [this, exe, args, onExit](std::function<void(bool)> done)
+    {
+        m_runner.run(exe, args, [onExit, done](int exitCode)
+        {
+            done(onExit ? onExit(exitCode) : exitCode == EXIT_SUCCESS);
+        });
+    }, dependencies);
+}
+
+JobGraph::JobId JobGraph::addTask(const QString& name, std::function<bool()> task, const QList<JobId>& dependencies)
+{
+    return add(name, [task](std::function<void(bool)> done)
+    {
+        done(task());
+    }, dependencies);
+}
+
+bool JobGraph::succeeded(JobId id) const
+{
+    return id >= 0 && id < static_cast<JobId>(m_nodes.size()) && m_nodes[id].state == State::Succeeded;
+}
+
+void JobGraph::run(std::function<void(bool)> onFinished)
+{
+    Q_ASSERT(!m_running);
+
+    m_onFinished = std::move(onFinished);
+    m_running = true;
+    m_active = 0;
+    m_remaining = static_cast<int>(m_nodes.size());
+
+    for (auto& node : m_nodes)
+        node.state = State::Pending;
+
+    schedule();
+}
+
+void JobGraph::schedule()
+{
+    // jobs that finish synchronously call back in here, the outer loop picks up what they unblocked
+    if (m_scheduling)
+        return;
+    m_scheduling = true;
+
+    bool started = true;
+    while (started && m_active < m_maxConcurrency)
+    {
+        started = false;
+
+        for (JobId id = 0; id < static_cast<JobId>(m_nodes.size()) && m_active < m_maxConcurrency; id++)
+        {
+            Node& node = m_nodes[id];
+            if (node.state != State::Pending)
+                continue;
+
+            const bool ready = std::all_of(node.dependencies.cbegin(), node.dependencies.cend(), [this](JobId dependency)
+            {
+                return m_nodes[dependency].state == State::Succeeded;
+            });
+            if (!ready)
+                continue;
+
+            node.state = State::Running;
+            m_active++;
+            started = true;
+
+            qDebug() << "[JobGraph] Starting" << node.name;
+            node.job([this, id](bool success)
+            {
+                finish(id, success);
+            });
+        }
+    }
+
+    m_scheduling = false;
+
+    if (m_running && m_remaining == 0)
+    {
+        m_running = false;
+
+        const bool allSucceeded = std::all_of(m_nodes.cbegin(), m_nodes.cend(), [](const Node& node)
+        {
+            return node.state == State::Succeeded;
+        });
+
+        if (m_onFinished)
+            m_onFinished(allSucceeded);
+    }
+}
+
+void JobGraph::finish(JobId id, bool success)
+{
+    Node& node = m_nodes[id];
+
+    // processes can report an error and a finish for the same run
+    if (node.state != State::Running)
+        return;
+
+    node.state = success ? State::Succeeded : State::Failed;
+    m_active--;
+    m_remaining--;
+
+    if (success)
+    {
+        qDebug() << "[JobGraph] Finished" << node.name;
+    }
+    else
+    {
+        qCritical() << "[JobGraph] Failed" << node.name;
+        cancelDependents(id);
+    }
+
+    schedule();
+}
+
+void JobGraph::cancelDependents(JobId id)
+{
+    for (const JobId dependent : m_nodes[id].dependents)
+    {
+        Node& node = m_nodes[dependent];
+        if (node.state != State::Pending)
+            continue;
+
+        node.state = State::Cancelled;
+        m_remaining--;
+        qWarning() << "[JobGraph] Cancelled" << node.name << "since" << m_nodes[id].name << "did not succeed";
+
+        cancelDependents(dependent);
+    }
+}
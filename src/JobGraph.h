@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Globals.h"
+
+#include "ProcessRunner.h"
+
+// Runs a set of jobs in dependency order, as many at once as the concurrency
+// limit allows. A failed job cancels the jobs that depend on it, the rest keep going.
+class JobGraph : public QObject
+{
+    Q_OBJECT
+
+public:
+    using JobId = int;
+
+    // Calls done exactly once with whether it succeeded, now or later
+    using Job = std::function<void(std::function<void(bool)> done)>;
+
+    explicit JobGraph(ProcessRunner& runner, QObject* parent = nullptr);
+
+    JobId add(const QString& name, Job job, const QList<JobId>& dependencies = {});
+
+    // Succeeds when onExit says so, or on a zero exit code without it
+    JobId addProcess(
+        const QString& name,
+        const QFileInfo& exe,
+        const QStringList& args,
+        const QList<JobId>& dependencies = {},
+        std::function<bool(int)> onExit = {}
+    );
+
+    // In-process work, runs on the ui thread
+    JobId addTask(const QString& name, std::function<bool()> task, const QList<JobId>& dependencies = {});
+
+    void setMaxConcurrency(int count) { m_maxConcurrency = std::max(1, count); }
+
+    // onFinished gets whether every job succeeded
+    void run(std::function<void(bool)> onFinished = {});
+
+    bool isRunning() const { return m_running; }
+    bool succeeded(JobId id) const;
+
+private:
+    enum class State
+    {
+        Pending,
+        Running,
+        Succeeded,
+        Failed,
+        Cancelled
+    };
+
+    struct Node
+    {
+        QString name;
+        Job job;
+        QList<JobId> dependencies;
+        QList<JobId> dependents;
+        State state = State::Pending;
+    };
+
+    void schedule();
+    void finish(JobId id, bool success);
+    void cancelDependents(JobId id);
+
+    ProcessRunner& m_runner;
+    std::vector<Node> m_nodes;
+
+    int m_maxConcurrency = 1;
+    int m_active = 0;
+    int m_remaining = 0;
+    bool m_running = false;
+    bool m_scheduling = false;
+
+    std::function<void(bool)> m_onFinished;
+};
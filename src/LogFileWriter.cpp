@@ -0,0 +1,204 @@
+#include "LogFileWriter.h"
+
+LogFileWriter::LogFileWriter(const QString& directory)
+    : m_directory(directory),
+      m_session(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"))
+{
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("LogFileWriter");
+    m_thread->start(QThread::LowPriority);
+}
+
+LogFileWriter::~LogFileWriter()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeAll();
+    }
+
+    m_thread->wait();
+}
+
+void LogFileWriter::write(qint64 timeMs, const QString& text)
+{
+    const int queued = m_queued.fetch_add(1, std::memory_order_relaxed);
+    if (queued >= QueueCapacity)
+    {
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    m_queue.push({ timeMs, text });
+
+    // the writer wakes up on its own every FlushIntervalMs, only hurry it when a burst piles up
+    if (queued + 1 == QueueCapacity / 4)
+        m_wake.wakeOne();
+}
+
+void LogFileWriter::flush()
+{
+    // the writer logging a fatal error can't wait on itself
+    if (QThread::currentThread() == m_thread.get())
+        return;
+
+    QMutexLocker lock(&m_mutex);
+    const quint64 request = ++m_flushRequested;
+    m_wake.wakeAll();
+
+    while (m_flushDone < request)
+    {
+        if (!m_flushed.wait(&m_mutex, 2000))
+            break;
+    }
+}
+
+void LogFileWriter::run()
+{
+    QDir().mkpath(m_directory);
+
+    openSegment();
+    pruneSegments();
+
+    bool leftoversCompressed = false;
+
+    while (true)
+    {
+        // the option can be switched on at any time, not just before the writer starts
+        if (m_compress && !leftoversCompressed)
+        {
+            compressLeftovers();
+            leftoversCompressed = true;
+        }
+
+        quint64 flushRequest;
+        {
+            QMutexLocker lock(&m_mutex);
+            if (!m_stopping && m_flushRequested == m_flushDone)
+                m_wake.wait(&m_mutex, FlushIntervalMs);
+            flushRequest = m_flushRequested;
+        }
+
+        drain();
+
+        {
+            QMutexLocker lock(&m_mutex);
+            m_flushDone = flushRequest;
+            m_flushed.wakeAll();
+        }
+
+        if (m_stopping)
+            break;
+    }
+
+    // whatever got queued while stopping
+    drain();
+    m_file.close();
+}
+
+void LogFileWriter::drain()
+{
+    Record record;
+    while (m_queue.tryPop(record))
+    {
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+        m_block += QDateTime::fromMSecsSinceEpoch(record.timeMs).toString("yyyy-MM-dd hh:mm:ss.zzz ").toUtf8();
+        m_block += record.text.toUtf8();
+        if (!m_block.endsWith('\n'))
+            m_block += '\n';
+
+        if (m_block.size() >= BlockBytes)
+            writeBlock();
+    }
+
+    if (const int dropped = m_dropped.exchange(0))
+    {
+        m_block += QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz ").toUtf8();
+        m_block += QString("[ Warning ] %1 log records dropped, the log writer fell behind\n").arg(dropped).toUtf8();
+    }
+
+    writeBlock();
+}
+
+void LogFileWriter::writeBlock()
+{
+    if (m_block.isEmpty())
+        return;
+
+    if (m_file.isOpen() && m_file.size() > 0 && m_file.size() + m_block.size() > SegmentBytes)
+        rotate();
+
+    // without a file the records are lost, but the queue keeps moving
+    if (m_file.isOpen())
+        m_file.write(m_block);
+
+    m_block.clear();
+}
+
+bool LogFileWriter::openSegment()
+{
+    const QString name = QString("h1modtools_%1_%2.log").arg(m_session).arg(m_segment, 3, 10, QChar('0'));
+    m_file.setFileName(m_directory + "/" + name);
+
+    // blocks are already batched here, QFile's own buffer would only copy them again
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered))
+    {
+        qWarning() << "Failed to open log file" << m_file.fileName() << ":" << m_file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+void LogFileWriter::rotate()
+{
+    const QString finished = m_file.fileName();
+    m_file.close();
+
+    if (m_compress)
+        compressSegment(finished);
+
+    m_segment++;
+    openSegment();
+    pruneSegments();
+}
+
+void LogFileWriter::compressSegment(const QString& path)
+{
+    QFile source(path);
+    if (!source.open(QIODevice::ReadOnly))
+        return;
+
+    const QByteArray compressed = qCompress(source.readAll());
+    source.close();
+
+    QSaveFile target(path + ".qz");
+    if (!target.open(QIODevice::WriteOnly))
+        return;
+
+    target.write(compressed);
+    if (target.commit())
+        QFile::remove(path);
+}
+
+void LogFileWriter::compressLeftovers()
+{
+    const QDir dir(m_directory);
+    for (const auto& name : dir.entryList(QStringList() << "h1modtools_*.log", QDir::Files))
+    {
+        if (!name.startsWith("h1modtools_" + m_session))
+            compressSegment(dir.filePath(name));
+    }
+}
+
+void LogFileWriter::pruneSegments()
+{
+    // session start, then a zero padded segment number, so names sort oldest first
+    const QDir dir(m_directory);
+    QStringList segments = dir.entryList(QStringList() << "h1modtools_*.log" << "h1modtools_*.log.qz", QDir::Files, QDir::Name);
+
+    while (segments.size() > KeptSegments)
+        QFile::remove(dir.filePath(segments.takeFirst()));
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Globals.h"
+
+#include "Utils/MpscQueue.h"
+
+// Writes log records to size rotated files from a thread of its own, so whoever logs
+// never waits on the disk. Records go through a bounded queue, when it's full they're
+// dropped and the file says how many.
+//
+// Segments are named h1modtools_<session start>_<n>.log and only the newest
+// KeptSegments of them stay around. Old segments can be compressed with qCompress
+// into .log.qz, a zlib stream behind a 4 byte big endian size.
+class LogFileWriter
+{
+public:
+    static constexpr int QueueCapacity = 65536;
+    static constexpr qint64 SegmentBytes = 8 * 1024 * 1024;
+    static constexpr int KeptSegments = 20;
+    static constexpr qsizetype BlockBytes = 64 * 1024;
+    static constexpr int FlushIntervalMs = 250;
+
+    explicit LogFileWriter(const QString& directory);
+    ~LogFileWriter(); // writes out everything still queued
+
+    // Any thread, never blocks
+    void write(qint64 timeMs, const QString& text);
+
+    // Blocks until everything written so far is on disk, for when the process is about to die
+    void flush();
+
+    // Takes effect with the next rotation, segments left by earlier sessions get
+    // compressed right away
+    void setCompressOldSegments(bool compress) { m_compress = compress; }
+
+private:
+    struct Record
+    {
+        qint64 timeMs = 0;
+        QString text;
+    };
+
+    void run();
+    void drain();
+    void writeBlock();
+    bool openSegment();
+    void rotate();
+    void compressSegment(const QString& path);
+    void compressLeftovers();
+    void pruneSegments();
+
+    QString m_directory;
+    QString m_session;
+    int m_segment = 0;
+    QFile m_file;
+    QByteArray m_block;
+
+    MpscQueue<Record> m_queue;
+    std::atomic<int> m_queued = 0;
+    std::atomic<int> m_dropped = 0;
+    std::atomic<bool> m_compress = false;
+    std::atomic<bool> m_stopping = false;
+
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QWaitCondition m_flushed;
+    quint64 m_flushRequested = 0; // guarded by m_mutex
+    quint64 m_flushDone = 0;      // guarded by m_mutex
+
+    std::unique_ptr<QThread> m_thread;
+};
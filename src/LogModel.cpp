@@ -0,0 +1,175 @@
+#include "LogModel.h"
+
+LogModel::LogModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int LogModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    return static_cast<int>(isFiltered() ? static_cast<qint64>(m_rows.size()) : totalLines());
+}
+
+qint64 LogModel::idOfRow(int row) const
+{
+    return isFiltered() ? m_rows[row] : m_store.firstId() + row;
+}
+
+QVariant LogModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return {};
+
+    const qint64 id = idOfRow(index.row());
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        return QString::fromUtf8(m_store.text(id));
+    case Qt::ForegroundRole:
+        return QBrush(levelColor(m_store.level(id)));
+    case Qt::ToolTipRole:
+        // rows share the first row's width, so long lines get elided and read in full here
+        return QDateTime::fromMSecsSinceEpoch(m_store.timeMs(id)).toString("hh:mm:ss.zzz") + "  " + QString::fromUtf8(m_store.text(id));
+    default:
+        return {};
+    }
+}
+
+void LogModel::append(LogLevel level, qint64 timeMs, QStringView text)
+{
+    const QByteArray utf8 = text.toUtf8();
+
+    qsizetype start = 0;
+    do
+    {
+        qsizetype end = utf8.indexOf('\n', start);
+        if (end < 0)
+            end = utf8.size();
+
+        QByteArrayView line = QByteArrayView(utf8).sliced(start, end - start);
+        if (line.endsWith('\r'))
+            line.chop(1);
+
+        m_store.append(level, timeMs, line);
+        start = end + 1;
+    } while (start < utf8.size());
+}
+
+void LogModel::publish()
+{
+    const qint64 end = m_store.endId();
+    if (end == m_published)
+        return;
+
+    if (isFiltered())
+    {
+        const std::vector<qint64> ids = m_store.find(m_published, end, m_levelMask, m_needle);
+        m_published = end;
+
+        if (!ids.empty())
+        {
+            const int first = static_cast<int>(m_rows.size());
+            beginInsertRows({}, first, first + static_cast<int>(ids.size()) - 1);
+            m_rows.insert(m_rows.end(), ids.begin(), ids.end());
+            endInsertRows();
+        }
+    }
+    else
+    {
+        const int first = rowCount();
+        beginInsertRows({}, first, first + static_cast<int>(end - m_published) - 1);
+        m_published = end;
+        endInsertRows();
+    }
+
+    trim();
+}
+
+void LogModel::trim()
+{
+    while (m_store.chunkCount() > MaxChunks)
+    {
+        const qint64 chunkEnd = m_store.oldestChunkEnd();
+
+        int count;
+        if (isFiltered())
+            count = static_cast<int>(std::lower_bound(m_rows.begin(), m_rows.end(), chunkEnd) - m_rows.begin());
+        else
+            count = static_cast<int>(chunkEnd - m_store.firstId());
+
+        if (count > 0)
+            beginRemoveRows({}, 0, count - 1);
+
+        m_store.dropOldestChunk();
+        if (isFiltered())
+            m_rows.erase(m_rows.begin(), m_rows.begin() + count);
+
+        if (count > 0)
+            endRemoveRows();
+    }
+}
+
+void LogModel::clear()
+{
+    beginResetModel();
+    m_store.clear();
+    m_rows.clear();
+    m_published = m_store.endId();
+    endResetModel();
+}
+
+QString LogModel::lineText(int row) const
+{
+    return QString::fromUtf8(m_store.text(idOfRow(row)));
+}
+
+void LogModel::setFilter(quint32 levelMask, const QString& searchText)
+{
+    const QByteArray needle = searchText.toUtf8();
+    if (levelMask == m_levelMask && needle == m_needle)
+        return;
+
+    // every line the new filter lets through, the old one did too
+    const bool narrowing = isFiltered()
+        && (levelMask & ~m_levelMask) == 0
+        && QLatin1StringView(needle).contains(QLatin1StringView(m_needle), Qt::CaseInsensitive);
+
+    beginResetModel();
+
+    m_levelMask = levelMask;
+    m_needle = needle;
+
+    if (!isFiltered())
+    {
+        m_rows = {};
+    }
+    else if (narrowing)
+    {
+        std::erase_if(m_rows, [this](qint64 id)
+        {
+            return !m_store.matches(id, m_levelMask, m_needle);
+        });
+    }
+    else
+    {
+        m_rows = m_store.find(m_store.firstId(), m_published, m_levelMask, m_needle);
+    }
+
+    endResetModel();
+}
+
+QColor LogModel::levelColor(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Debug:    return Qt::cyan;
+    case LogLevel::Warning:  return Qt::yellow;
+    case LogLevel::Critical: return Qt::red;
+    case LogLevel::Fatal:    return Qt::darkRed;
+    default:                 return Qt::white;
+    }
+}
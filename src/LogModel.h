@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Globals.h"
+
+#include "LogStore.h"
+
+// Log lines for a list view. Views only ask for the rows they show, so a million
+// lines cost their bytes in the store and nothing per row until scrolled to.
+//
+// Lines are appended in batches: append() stores them and publish() hands everything
+// stored since the last publish to the view in one insert. Once the store holds more
+// than MaxChunks chunks the oldest one is dropped.
+class LogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MaxChunks = 64;
+
+    explicit LogModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = {}) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    // Splits text into lines, a trailing '\n' doesn't add an empty one
+    void append(LogLevel level, qint64 timeMs, QStringView text);
+    void publish();
+    void clear();
+
+    QString lineText(int row) const;
+    qint64 totalLines() const { return m_published - m_store.firstId(); }
+
+    // Rows are the lines whose level is in levelMask and that contain searchText, ascii
+    // case insensitively. Narrowing a filter, like typing on to a search, only rechecks
+    // the rows already shown instead of the whole store.
+    void setFilter(quint32 levelMask, const QString& searchText);
+    bool isFiltered() const { return m_levelMask != AllLogLevels || !m_needle.isEmpty(); }
+
+    static QColor levelColor(LogLevel level);
+
+private:
+    qint64 idOfRow(int row) const;
+    void trim();
+
+    LogStore m_store;
+    qint64 m_published = 0; // lines from here on are stored but not rows yet
+
+    quint32 m_levelMask = AllLogLevels;
+    QByteArray m_needle;
+    std::vector<qint64> m_rows; // ids of the matching lines, only kept while filtered
+};
@@ -1,94 +1,283 @@
 #include "LogRedirector.h"
 
-#include <QMetaObject>
-#include <QTextCharFormat>
-#include <QTextCursor>
-#include <QTextEdit>
-#include <QSocketNotifier>
+#include <QListView>
+#include <QScrollBar>
 
+#include "Utils/LineRingBuffer.h"
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
 #include <io.h>
 #include <fcntl.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
 #include <stdio.h>
 
+namespace
+{
+#ifdef Q_OS_WIN
+    bool createPipe(int fds[2]) { return _pipe(fds, LogRedirector::ReadBufferBytes, _O_BINARY | _O_NOINHERIT) == 0; }
+    int duplicate(int fd) { return _dup(fd); }
+    int duplicateTo(int fd, int target) { return _dup2(fd, target); }
+    int closeFd(int fd) { return _close(fd); }
+    int readFd(int fd, char* buffer, int size) { return _read(fd, buffer, size); }
+    int writeFd(int fd, const char* data, int size) { return _write(fd, data, size); }
+#else
+    bool createPipe(int fds[2])
+    {
+        if (::pipe(fds) != 0)
+            return false;
+
+        // only the write end becomes stdout, which children are meant to inherit
+        ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        return true;
+    }
+    int duplicate(int fd) { return ::dup(fd); }
+    int duplicateTo(int fd, int target) { return ::dup2(fd, target); }
+    int closeFd(int fd) { return ::close(fd); }
+    int readFd(int fd, char* buffer, int size) { return static_cast<int>(::read(fd, buffer, size)); }
+    int writeFd(int fd, const char* data, int size) { return static_cast<int>(::write(fd, data, size)); }
+#endif
+}
+
 LogRedirector* LogRedirector::instance = nullptr;
 
-LogRedirector::LogRedirector(QTextEdit* targetEdit, QObject* parent)
-    : QObject(parent), outputEdit(targetEdit), notifier(nullptr)
+LogRedirector::LogRedirector(QListView* targetView, QObject* parent)
+    : QObject(parent), outputView(targetView), logFile("logs")
 {
-    Q_ASSERT(outputEdit);
-    outputEdit->setReadOnly(true);
+    Q_ASSERT(outputView);
+
+    // Every row is one line of the same height, so the view lays out only what it shows
+    outputView->setModel(&logModel);
+    outputView->setUniformItemSizes(true);
+    outputView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    outputView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    outputView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+
     setupPipe();
+
+    connect(&flushTimer, &QTimer::timeout, this, &LogRedirector::flushPending);
+    flushTimer.start(FlushIntervalMs);
 }
 
 LogRedirector::~LogRedirector()
 {
-    if (notifier)
-        delete notifier;
+    if (instance == this) {
+        qInstallMessageHandler(nullptr);
+        instance = nullptr;
+    }
+
+    stopPipe();
 }
 
 void LogRedirector::setupPipe()
 {
-    if (_pipe(pipeFd, 1024, _O_TEXT) == -1) {
-        outputEdit->append("Failed to create pipe.");
+    if (!createPipe(pipeFd)) {
+        appendMessage("Failed to create pipe.", LogLevel::Critical);
         return;
     }
 
-    // Redirect stdout and stderr to the pipe's write end
-    _dup2(pipeFd[1], _fileno(stdout));
-    _dup2(pipeFd[1], _fileno(stderr));
+#ifndef Q_OS_WIN
+    if (::pipe(wakeFd) != 0)
+        wakeFd[0] = wakeFd[1] = -1;
+#endif
+
+    fflush(stdout);
+    fflush(stderr);
+
+    // Keep the real stdout around for the message handler, then redirect stdout and
+    // stderr to the pipe's write end. A gui process may have no stdout at all.
+    savedStdout = duplicate(fileno(stdout));
+    savedStderr = duplicate(fileno(stderr));
+    duplicateTo(pipeFd[1], fileno(stdout));
+    duplicateTo(pipeFd[1], fileno(stderr));
+
+    // stdout and stderr are the write end now
+    closeFd(pipeFd[1]);
+    pipeFd[1] = -1;
 
-    // Close the duplicate write fd (optional cleanup)
-    _close(pipeFd[1]);
+    pipeReader = std::make_shared<PipeReader>();
+    pipeReader->owner = this;
 
-    notifier = new QSocketNotifier(pipeFd[0], QSocketNotifier::Read, this);
-    connect(notifier, &QSocketNotifier::activated, this, &LogRedirector::readFromPipe);
+    readerThread.reset(QThread::create(&LogRedirector::readPipe, pipeFd[0], wakeFd[0], pipeReader));
+    readerThread->setObjectName("LogRedirector");
+    readerThread->start();
 }
 
-void LogRedirector::readFromPipe()
+void LogRedirector::readPipe(int fd, int wake, std::shared_ptr<PipeReader> reader)
 {
-    char buffer[1024];
+#ifdef Q_OS_WIN
+    // CancelSynchronousIo needs a real handle, GetCurrentThread only gives a pseudo one
+    HANDLE self = nullptr;
+    if (DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &self, THREAD_TERMINATE, FALSE, 0))
+        reader->thread = self;
+#endif
+
+    LineRingBuffer lines(ReadBufferBytes);
+    QByteArray buffer(ReadBufferBytes, Qt::Uninitialized);
+
+    const auto onLine = [&reader](QByteArrayView line)
+    {
+        QMutexLocker lock(&reader->mutex);
+        if (reader->owner)
+            reader->owner->appendCapturedLine(line);
+    };
+
     while (true) {
-        int bytes = _read(pipeFd[0], buffer, sizeof(buffer) - 1);
+#ifndef Q_OS_WIN
+        pollfd fds[2] = {
+            { fd, POLLIN, 0 },
+            { wake, POLLIN, 0 },
+        };
+        if (::poll(fds, wake >= 0 ? 2 : 1, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        // drain what's left before stopping
+        if (fds[1].revents && !(fds[0].revents & POLLIN))
+            break;
+#endif
+
+        // Blocks until something is written, ends once every write end is closed or,
+        // on windows, when stopPipe cancels the read
+        const int bytes = readFd(fd, buffer.data(), static_cast<int>(buffer.size()));
+#ifndef Q_OS_WIN
+        if (bytes < 0 && errno == EINTR)
+            continue;
+#endif
         if (bytes <= 0)
             break;
 
-        buffer[bytes] = '\0';
+        lines.append(buffer.constData(), bytes);
+        lines.takeLines(onLine);
+    }
+
+    lines.takeLines(onLine, true);
+}
+
+void LogRedirector::stopPipe()
+{
+    if (!readerThread)
+        return;
+
+    fflush(stdout);
+    fflush(stderr);
+
+    // Putting the real stdout and stderr back closes the last write ends of the pipe
+    if (savedStdout >= 0) {
+        duplicateTo(savedStdout, fileno(stdout));
+        closeFd(savedStdout);
+        savedStdout = -1;
+    }
+    if (savedStderr >= 0) {
+        duplicateTo(savedStderr, fileno(stderr));
+        closeFd(savedStderr);
+        savedStderr = -1;
+    }
+
+#ifdef Q_OS_WIN
+    // A child that inherited stdout keeps the pipe open, so the read has to be cancelled.
+    // The reader may be between two reads when a cancel lands, so keep at it for a while.
+    QDeadlineTimer deadline(2000);
+    while (!readerThread->wait(QDeadlineTimer(50)) && !deadline.hasExpired()) {
+        if (void* thread = pipeReader->thread)
+            CancelSynchronousIo(thread);
+    }
+#else
+    // same for a child here, the wake pipe gets the reader out of poll
+    if (wakeFd[1] >= 0)
+        writeFd(wakeFd[1], "x", 1);
+    readerThread->wait(QDeadlineTimer(2000));
+#endif
+
+    if (!readerThread->isFinished()) {
+        // Killing the thread could leave a lock held for good. Cut it off from this
+        // redirector and let it go, along with the fds it may still be reading.
+        {
+            QMutexLocker lock(&pipeReader->mutex);
+            pipeReader->owner = nullptr;
+        }
 
-        QString text = QString::fromLocal8Bit(buffer);
+        qWarning() << "The log pipe reader didn't stop, leaving it behind";
 
-        // Determine color based on message content
-        QColor color = Qt::white;
-        if (text.contains("[ Debug ]", Qt::CaseInsensitive))
-            color = Qt::cyan;
-        else if (text.contains("[ Warning ]", Qt::CaseInsensitive))
-            color = Qt::yellow;
-        else if (text.contains("[ Critical ]", Qt::CaseInsensitive) || text.contains("[ Error ]", Qt::CaseInsensitive))
-            color = Qt::red;
-        else if (text.contains("[ Fatal ]", Qt::CaseInsensitive))
-            color = Qt::darkRed;
+        QThread* leaked = readerThread.release();
+        connect(leaked, &QThread::finished, leaked, &QObject::deleteLater);
+        pipeReader.reset();
+        pipeFd[0] = -1;
+        wakeFd[0] = wakeFd[1] = -1;
+        return;
+    }
+
+    readerThread.reset();
+
+#ifdef Q_OS_WIN
+    if (void* thread = pipeReader->thread)
+        CloseHandle(thread);
+#endif
+    pipeReader.reset();
 
-        appendColoredText(text, color);
+    closeFd(pipeFd[0]);
+    pipeFd[0] = -1;
+
+    for (int& fd : wakeFd) {
+        if (fd >= 0)
+            closeFd(fd);
+        fd = -1;
     }
 }
 
-void LogRedirector::appendColoredText(const QString& msg, const QColor& color)
+void LogRedirector::appendCapturedLine(QByteArrayView line)
 {
-    // Use queued invoke to safely update UI from the pipe notifier's thread
-    QMetaObject::invokeMethod(outputEdit, [=]() {
-        QTextCharFormat fmt;
-        fmt.setForeground(color);
-
-        QTextCursor cursor = outputEdit->textCursor();
-        cursor.movePosition(QTextCursor::End);
-        cursor.insertText(msg, fmt);
-
-        // Add newline if missing to keep formatting consistent
-        if (!msg.endsWith('\n'))
-            cursor.insertText("\n");
-
-        outputEdit->setTextCursor(cursor);
-        outputEdit->ensureCursorVisible();
-    });
+    QString text = QString::fromLocal8Bit(line);
+
+    // Determine level based on message content
+    LogLevel level = LogLevel::Info;
+    if (text.contains("[ Debug ]", Qt::CaseInsensitive))
+        level = LogLevel::Debug;
+    else if (text.contains("[ Warning ]", Qt::CaseInsensitive))
+        level = LogLevel::Warning;
+    else if (text.contains("[ Critical ]", Qt::CaseInsensitive) || text.contains("[ Error ]", Qt::CaseInsensitive))
+        level = LogLevel::Critical;
+    else if (text.contains("[ Fatal ]", Qt::CaseInsensitive))
+        level = LogLevel::Fatal;
+
+    appendMessage(text, level);
+}
+
+void LogRedirector::appendMessage(const QString& msg, LogLevel level)
+{
+    // Lock free, so any thread can log. The ui thread picks it up on the next flush.
+    const qint64 timeMs = QDateTime::currentMSecsSinceEpoch();
+    pending.push({ msg, level, timeMs });
+    logFile.write(timeMs, msg);
+}
+
+void LogRedirector::flushPending()
+{
+    Entry entry;
+    bool any = false;
+    while (pending.tryPop(entry)) {
+        logModel.append(entry.level, entry.timeMs, entry.text);
+        any = true;
+    }
+
+    if (!any)
+        return;
+
+    // Only follow the output when the user hasn't scrolled up to read something
+    QScrollBar* scrollBar = outputView->verticalScrollBar();
+    const bool atBottom = scrollBar->value() >= scrollBar->maximum();
+
+    logModel.publish();
+
+    if (atBottom)
+        outputView->scrollToBottom();
 }
 
 void LogRedirector::installQtMessageHandler()
@@ -109,18 +298,29 @@ void LogRedirector::qtMessageHandler(QtMsgType type, const QMessageLogContext&,
 
     QString full = prefix + msg;
 
-    // Print to stdout/stderr explicitly and flush immediately
-    fprintf(stdout, "%s\n", full.toUtf8().constData());
-    fflush(stdout);
+    // Echo to the real stdout, the redirected one would feed it back in through the pipe
+    if (instance && instance->savedStdout >= 0) {
+        const QByteArray line = full.toUtf8() + '\n';
+        writeFd(instance->savedStdout, line.constData(), static_cast<int>(line.size()));
+    }
+    else {
+        fprintf(stdout, "%s\n", full.toUtf8().constData());
+        fflush(stdout);
+    }
 
-    if (instance && instance->outputEdit) {
-        QColor color = Qt::white;
+    if (instance) {
+        LogLevel level = LogLevel::Info;
         switch (type) {
-        case QtDebugMsg:    color = Qt::cyan; break;
-        case QtWarningMsg:  color = Qt::yellow; break;
-        case QtCriticalMsg: color = Qt::red; break;
-        case QtFatalMsg:    color = Qt::darkRed; break;
+        case QtDebugMsg:    level = LogLevel::Debug; break;
+        case QtWarningMsg:  level = LogLevel::Warning; break;
+        case QtCriticalMsg: level = LogLevel::Critical; break;
+        case QtFatalMsg:    level = LogLevel::Fatal; break;
+        default: break;
         }
-        instance->appendColoredText(full, color);
+        instance->appendMessage(full, level);
+
+        // qFatal aborts right after this, get the reason on disk first
+        if (type == QtFatalMsg)
+            instance->logFile.flush();
     }
 }
\ No newline at end of file
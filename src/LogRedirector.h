@@ -2,26 +2,69 @@
 
 #include "Globals.h"
 
+#include "LogFileWriter.h"
+#include "LogModel.h"
+#include "Utils/MpscQueue.h"
+
 class LogRedirector : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit LogRedirector(QTextEdit* targetEdit, QObject* parent = nullptr);
+    // Messages are queued from any thread and handed to the model behind targetView in
+    // batches, about 30 times a second. They're also written to logs/ in the background.
+    explicit LogRedirector(QListView* targetView, QObject* parent = nullptr);
     ~LogRedirector();
 
     void installQtMessageHandler();
 
+    LogModel* model() { return &logModel; }
+    LogFileWriter& fileWriter() { return logFile; }
+
+    static constexpr int FlushIntervalMs = 33;
+    static constexpr int ReadBufferBytes = 64 * 1024;
+
 private slots:
-    void readFromPipe();
+    void flushPending();
 
 private:
+    struct Entry
+    {
+        QString text;
+        LogLevel level = LogLevel::Info;
+        qint64 timeMs = 0;
+    };
+
+    // What the pipe reader shares with the redirector. A reader that won't stop is left
+    // running on its own, from then on owner is null and the lines it reads go nowhere.
+    struct PipeReader
+    {
+        QMutex mutex;
+        LogRedirector* owner = nullptr; // guarded by mutex
+        std::atomic<void*> thread = nullptr; // windows only, lets stopPipe cancel a blocked read
+    };
+
+    // stdout and stderr go into a pipe that a thread of its own reads, so whatever
+    // the process or a library prints shows up as log lines
     void setupPipe();
-    void appendColoredText(const QString& msg, const QColor& color);
+    static void readPipe(int fd, int wake, std::shared_ptr<PipeReader> reader);
+    void stopPipe();
+    void appendCapturedLine(QByteArrayView line);
+    void appendMessage(const QString& msg, LogLevel level);
+
+    int pipeFd[2] = { -1, -1 };
+    int wakeFd[2] = { -1, -1 }; // posix only, wakes the reader up to stop
+    int savedStdout = -1;       // the real ones, put back when the redirector goes away
+    int savedStderr = -1;
+    std::unique_ptr<QThread> readerThread;
+    std::shared_ptr<PipeReader> pipeReader;
+
+    QListView* outputView;
+    LogModel logModel;
+    LogFileWriter logFile;
 
-    int pipeFd[2];
-    QSocketNotifier* notifier;
-    QTextEdit* outputEdit;
+    MpscQueue<Entry> pending;
+    QTimer flushTimer;
 
     static LogRedirector* instance;
     static void qtMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg);
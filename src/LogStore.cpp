@@ -0,0 +1,138 @@
+#include "LogStore.h"
+
+#include <QtConcurrent/QtConcurrent>
+
+QByteArrayView LogStore::Chunk::text(qsizetype index) const
+{
+    const qsizetype begin = lines[index].offset;
+    const qsizetype end = index + 1 < static_cast<qsizetype>(lines.size()) ? lines[index + 1].offset : bytes.size();
+    return QByteArrayView(bytes).sliced(begin, end - begin);
+}
+
+void LogStore::append(LogLevel level, qint64 timeMs, QByteArrayView text)
+{
+    // a line bigger than a whole chunk still gets one to itself
+    if (m_chunks.empty()
+        || static_cast<qsizetype>(m_chunks.back().lines.size()) >= ChunkLines
+        || (!m_chunks.back().lines.empty() && m_chunks.back().bytes.size() + text.size() > ChunkBytes))
+    {
+        Chunk& chunk = m_chunks.emplace_back();
+        chunk.firstId = m_nextId;
+        chunk.bytes.reserve(std::max(ChunkBytes, text.size()));
+        chunk.lines.reserve(ChunkLines);
+    }
+
+    Chunk& chunk = m_chunks.back();
+    chunk.lines.push_back({ timeMs, static_cast<quint32>(chunk.bytes.size()), level });
+    chunk.bytes.append(text);
+    m_nextId++;
+}
+
+void LogStore::clear()
+{
+    m_chunks.clear();
+}
+
+qint64 LogStore::oldestChunkEnd() const
+{
+    if (m_chunks.empty())
+        return m_nextId;
+
+    const Chunk& oldest = m_chunks.front();
+    return oldest.firstId + static_cast<qint64>(oldest.lines.size());
+}
+
+void LogStore::dropOldestChunk()
+{
+    if (!m_chunks.empty())
+        m_chunks.pop_front();
+}
+
+const LogStore::Chunk& LogStore::chunkOf(qint64 id) const
+{
+    Q_ASSERT(id >= firstId() && id < endId());
+
+    const auto it = std::upper_bound(m_chunks.begin(), m_chunks.end(), id, [](qint64 value, const Chunk& chunk)
+    {
+        return value < chunk.firstId;
+    });
+    return *std::prev(it);
+}
+
+LogLevel LogStore::level(qint64 id) const
+{
+    const Chunk& chunk = chunkOf(id);
+    return chunk.lines[id - chunk.firstId].level;
+}
+
+qint64 LogStore::timeMs(qint64 id) const
+{
+    const Chunk& chunk = chunkOf(id);
+    return chunk.lines[id - chunk.firstId].timeMs;
+}
+
+QByteArrayView LogStore::text(qint64 id) const
+{
+    const Chunk& chunk = chunkOf(id);
+    return chunk.text(id - chunk.firstId);
+}
+
+namespace
+{
+    bool lineMatches(LogLevel level, QByteArrayView text, quint32 levelMask, QByteArrayView needle)
+    {
+        if (!(levelMask & logLevelBit(level)))
+            return false;
+
+        // utf-8 bytes as latin-1 only fold ascii letters, which is what log searches are for
+        return needle.isEmpty()
+            || QLatin1StringView(text).contains(QLatin1StringView(needle), Qt::CaseInsensitive);
+    }
+}
+
+bool LogStore::matches(qint64 id, quint32 levelMask, QByteArrayView needle) const
+{
+    const Chunk& chunk = chunkOf(id);
+    const qsizetype index = id - chunk.firstId;
+    return lineMatches(chunk.lines[index].level, chunk.text(index), levelMask, needle);
+}
+
+std::vector<qint64> LogStore::find(qint64 from, qint64 to, quint32 levelMask, QByteArrayView needle) const
+{
+    from = std::max(from, firstId());
+    to = std::min(to, endId());
+
+    QList<const Chunk*> chunks;
+    for (const auto& chunk : m_chunks)
+    {
+        const qint64 chunkEnd = chunk.firstId + static_cast<qint64>(chunk.lines.size());
+        if (chunkEnd > from && chunk.firstId < to)
+            chunks << &chunk;
+    }
+
+    const QList<std::vector<qint64>> found = QtConcurrent::blockingMapped(chunks, [from, to, levelMask, needle](const Chunk* chunk)
+    {
+        std::vector<qint64> ids;
+        const qsizetype begin = std::max<qint64>(from - chunk->firstId, 0);
+        const qsizetype end = std::min<qint64>(to - chunk->firstId, static_cast<qint64>(chunk->lines.size()));
+
+        for (qsizetype i = begin; i < end; i++)
+        {
+            if (lineMatches(chunk->lines[i].level, chunk->text(i), levelMask, needle))
+                ids.push_back(chunk->firstId + i);
+        }
+
+        return ids;
+    });
+
+    size_t total = 0;
+    for (const auto& ids : found)
+        total += ids.size();
+
+    std::vector<qint64> result;
+    result.reserve(total);
+    for (const auto& ids : found)
+        result.insert(result.end(), ids.begin(), ids.end());
+
+    return result;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Globals.h"
+
+#include <deque>
+
+enum class LogLevel : quint8
+{
+    Debug,
+    Info,
+    Warning,
+    Critical,
+    Fatal,
+};
+
+// Bit per LogLevel, for level filters
+constexpr quint32 logLevelBit(LogLevel level) { return 1u << static_cast<quint32>(level); }
+constexpr quint32 AllLogLevels = (1u << (static_cast<quint32>(LogLevel::Fatal) + 1)) - 1;
+
+// Append-only log lines, kept in chunks so old output can be let go a chunk at a time.
+// A line is its level, when it was logged and where its utf-8 text starts in the
+// chunk's byte arena, which is 16 bytes on top of the text itself.
+//
+// Line ids keep counting up across clear() and dropOldestChunk(), so an id stays valid
+// for as long as its chunk is around.
+class LogStore
+{
+public:
+    static constexpr qsizetype ChunkBytes = 2 * 1024 * 1024;
+    static constexpr qsizetype ChunkLines = 32768;
+
+    // text is one line, without its '\n'
+    void append(LogLevel level, qint64 timeMs, QByteArrayView text);
+    void clear();
+
+    qint64 firstId() const { return m_chunks.empty() ? m_nextId : m_chunks.front().firstId; }
+    qint64 endId() const { return m_nextId; }
+    qint64 lineCount() const { return endId() - firstId(); }
+
+    int chunkCount() const { return static_cast<int>(m_chunks.size()); }
+    qint64 oldestChunkEnd() const;
+    void dropOldestChunk();
+
+    LogLevel level(qint64 id) const;
+    qint64 timeMs(qint64 id) const;
+    QByteArrayView text(qint64 id) const;
+
+    // needle matches ascii case insensitively, an empty one matches every line
+    bool matches(qint64 id, quint32 levelMask, QByteArrayView needle) const;
+
+    // Ids in [from, to) that match, in order. Chunks are scanned on the thread pool.
+    std::vector<qint64> find(qint64 from, qint64 to, quint32 levelMask, QByteArrayView needle) const;
+
+private:
+    struct Line
+    {
+        qint64 timeMs;
+        quint32 offset;
+        LogLevel level;
+    };
+
+    struct Chunk
+    {
+        qint64 firstId = 0;
+        QByteArray bytes;
+        std::vector<Line> lines;
+
+        QByteArrayView text(qsizetype index) const;
+    };
+
+    const Chunk& chunkOf(qint64 id) const;
+
+    std::deque<Chunk> m_chunks;
+    qint64 m_nextId = 0;
+};
@@ -2,67 +2,184 @@
 #include <QDir>
 #include <QFile>
 
+#include <array>
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#include <psapi.h>
+#endif
+
 ProcessRunner::ProcessRunner(QObject* parent)
     : QObject(parent)
 {
+    m_clock.start();
 }
 
-void ProcessRunner::readOutputFromProcess(QProcess* process)
+namespace
 {
-    auto handleLogLine = [](const QString& line) 
+    struct LevelConfig
     {
-        struct LevelConfig
-        {
-            QString prefix;
-            QtMsgType type;
-        };
+        QByteArrayView prefix;
+        QtMsgType type;
+    };
 
-        static const LevelConfig configs[] = 
-        {
-            { "[ DEBUG ]",   QtInfoMsg },     // Mapping Debug to Info to avoid noise
-            { "[ INFO ]",    QtInfoMsg },
-            { "[ WARNING ]", QtWarningMsg },
-            { "[ ERROR ]",   QtCriticalMsg },
-            { "[ FATAL ]",   QtCriticalMsg }
-        };
-
-        for (const auto& config : configs)
+    // zonetool prefixes are "[ LEVEL ]", indexed by the level's first letter
+    constexpr std::array<LevelConfig, 26> makeLevelTable()
+    {
+        std::array<LevelConfig, 26> table{};
+        table['D' - 'A'] = { "[ DEBUG ]",   QtInfoMsg };     // Mapping Debug to Info to avoid noise
+        table['I' - 'A'] = { "[ INFO ]",    QtInfoMsg };
+        table['W' - 'A'] = { "[ WARNING ]", QtWarningMsg };
+        table['E' - 'A'] = { "[ ERROR ]",   QtCriticalMsg };
+        table['F' - 'A'] = { "[ FATAL ]",   QtCriticalMsg };
+        return table;
+    }
+
+    constexpr auto levelTable = makeLevelTable();
+
+    // One lookup and one compare per line, unknown lines stay info
+    QtMsgType classifyLine(QByteArrayView& line)
+    {
+        if (line.size() > 2 && line[0] == '[' && line[1] == ' ')
         {
-            if (line.startsWith(config.prefix, Qt::CaseInsensitive))
+            const char letter = static_cast<char>(line[2] & ~0x20); // upper case
+            if (letter >= 'A' && letter <= 'Z')
             {
-                QString message = line.mid(config.prefix.length()).trimmed();
-
-                switch (config.type)
+                const LevelConfig& config = levelTable[letter - 'A'];
+                if (!config.prefix.isEmpty() && line.size() >= config.prefix.size() &&
+                    line.first(config.prefix.size()).compare(config.prefix, Qt::CaseInsensitive) == 0)
                 {
-                case QtDebugMsg:    qDebug().noquote() << message; break;
-                case QtInfoMsg:     qInfo().noquote() << message; break;
-                case QtWarningMsg:  qWarning().noquote() << message; break;
-                case QtCriticalMsg: qCritical().noquote() << message; break;
-                case QtFatalMsg:    qFatal("%s", qUtf8Printable(message)); break;
+                    line = line.sliced(config.prefix.size());
+                    return config.type;
                 }
+            }
+        }
+
+        return QtInfoMsg;
+    }
+
+    // Holds on to the child so its times and peak working set can still be read once it exited
+    class ProcessUsage
+    {
+    public:
+        ProcessUsage() = default;
+        ProcessUsage(const ProcessUsage&) = delete;
+        ProcessUsage& operator=(const ProcessUsage&) = delete;
+
+        ~ProcessUsage()
+        {
+#ifdef Q_OS_WIN
+            if (m_handle)
+                CloseHandle(m_handle);
+#endif
+        }
+
+        void attach(qint64 pid)
+        {
+#ifdef Q_OS_WIN
+            m_handle = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+#else
+            Q_UNUSED(pid);
+#endif
+        }
+
+        void fill(ProcessSample& sample) const
+        {
+#ifdef Q_OS_WIN
+            if (!m_handle)
                 return;
+
+            // FILETIME counts 100ns ticks
+            const auto toUs = [](const FILETIME& time)
+            {
+                return static_cast<qint64>((static_cast<quint64>(time.dwHighDateTime) << 32 | time.dwLowDateTime) / 10);
+            };
+
+            FILETIME creation, exit, kernel, user;
+            if (GetProcessTimes(m_handle, &creation, &exit, &kernel, &user))
+            {
+                sample.userCpuUs = toUs(user);
+                sample.kernelCpuUs = toUs(kernel);
             }
+
+            PROCESS_MEMORY_COUNTERS counters{};
+            if (GetProcessMemoryInfo(m_handle, &counters, sizeof(counters)))
+                sample.peakWorkingSet = static_cast<qint64>(counters.PeakWorkingSetSize);
+#else
+            Q_UNUSED(sample);
+#endif
         }
 
-        // Default fallback
-        qInfo().noquote() << line.trimmed();
+    private:
+#ifdef Q_OS_WIN
+        HANDLE m_handle = nullptr;
+#endif
     };
 
-    QByteArray output = process->readAll();
-    QStringList lines = QString::fromLocal8Bit(output).split('\n', Qt::SkipEmptyParts);
-    for (const QString& line : lines)
+    void emitBatch(QtMsgType type, const QByteArray& batch)
     {
-        if (!line.isEmpty())
+        if (batch.isEmpty())
+            return;
+
+        const QString message = QString::fromLocal8Bit(batch);
+        switch (type)
         {
-            handleLogLine(line);
+        case QtDebugMsg:    qDebug().noquote() << message; break;
+        case QtInfoMsg:     qInfo().noquote() << message; break;
+        case QtWarningMsg:  qWarning().noquote() << message; break;
+        case QtCriticalMsg: qCritical().noquote() << message; break;
+        case QtFatalMsg:    qFatal("%s", qUtf8Printable(message)); break;
         }
     }
 }
 
-void ProcessRunner::run(
+void ProcessRunner::readOutputFromProcess(
+    QProcess* process,
+    LineRingBuffer& buffer,
+    bool flush,
+    const LineHandler& onLine,
+    qint64 receivedUs,
+    const std::function<bool(QByteArrayView)>& consume)
+{
+    buffer.readFrom(process);
+
+    // consecutive lines of the same level go out as one message, decoded once
+    QtMsgType batchType = QtInfoMsg;
+    QByteArray batch;
+
+    buffer.takeLines([&](QByteArrayView line)
+    {
+        const QtMsgType type = classifyLine(line);
+        line = line.trimmed();
+        if (line.isEmpty())
+            return;
+
+        if (consume && consume(line))
+            return;
+
+        if (onLine)
+            onLine(line, receivedUs);
+
+        if (type != batchType)
+        {
+            emitBatch(batchType, batch);
+            batch.clear();
+            batchType = type;
+        }
+
+        if (!batch.isEmpty())
+            batch += '\n';
+        batch.append(line);
+    }, flush);
+
+    emitBatch(batchType, batch);
+}
+
+QPointer<QProcess> ProcessRunner::run(
     const QFileInfo& exe,
     const QStringList& args,
-    std::function<void(int)> onFinish)
+    std::function<void(int)> onFinish,
+    LineHandler onLine)
 {
     const QString fullPath = exe.absoluteFilePath();
 
@@ -70,7 +187,7 @@ void ProcessRunner::run(
     {
         qCritical() << "Missing executable:" << fullPath;
         if (onFinish) onFinish(-1);
-        return;
+        return nullptr;
     }
 
     auto* proc = new QProcess(this);
@@ -79,21 +196,53 @@ void ProcessRunner::run(
     proc->setWorkingDirectory(exe.absolutePath());
     proc->setProcessChannelMode(QProcess::MergedChannels);
 
-    connect(proc, &QProcess::readyRead, [proc]()
+    // partial lines wait in the buffer for the rest of their bytes
+    auto output = std::make_shared<LineRingBuffer>();
+
+    auto sample = std::make_shared<ProcessSample>();
+    sample->name = exe.fileName();
+    sample->arguments = args;
+    sample->lane = m_telemetry.acquireLane();
+    sample->startUs = m_telemetry.elapsedUs();
+
+    auto usage = std::make_shared<ProcessUsage>();
+
+    // a process that fails to start never finishes, record it either way but only once
+    const auto recordSample = [this, sample, usage](int exitCode)
+    {
+        if (sample->lane < 0)
+            return;
+
+        sample->exitCode = exitCode;
+        sample->wallUs = m_telemetry.elapsedUs() - sample->startUs;
+        usage->fill(*sample);
+        m_telemetry.record(*sample);
+        sample->lane = -1;
+    };
+
+    connect(proc, &QProcess::started, this, [proc, usage]()
     {
-        readOutputFromProcess(proc);
+        usage->attach(proc->processId());
     });
 
-    connect(proc, &QProcess::errorOccurred, [onFinish](QProcess::ProcessError error)
+    connect(proc, &QProcess::readyRead, this, [this, proc, output, onLine]()
+    {
+        readOutputFromProcess(proc, *output, false, onLine, elapsedUs());
+    });
+
+    connect(proc, &QProcess::errorOccurred, [onFinish, recordSample](QProcess::ProcessError error)
     {
         qWarning() << "Process error occurred:" << error;
+        if (error == QProcess::FailedToStart)
+            recordSample(-1);
         if(onFinish)
 			onFinish(-1);
     });
 
-    connect(proc, &QProcess::finished, this, [proc, onFinish](int code)
+    connect(proc, &QProcess::finished, this, [this, proc, output, onFinish, onLine, recordSample](int code)
     {
-        readOutputFromProcess(proc);
+        readOutputFromProcess(proc, *output, true, onLine, elapsedUs());
+        recordSample(code);
 
         if (onFinish)
             onFinish(code);
@@ -102,4 +251,269 @@ void ProcessRunner::run(
     });
 
     proc->start();
-}
\ No newline at end of file
+    return proc;
+}
+
+void ProcessRunner::killProcessTree(QProcess* process)
+{
+    if (!process || process->state() == QProcess::NotRunning)
+        return;
+
+#ifdef Q_OS_WIN
+    // the tools spawn helpers of their own, taskkill /T takes those down too
+    QProcess::execute("taskkill", { "/PID", QString::number(process->processId()), "/T", "/F" });
+#endif
+
+    process->kill();
+}
+
+namespace
+{
+    constexpr QByteArrayView workerReady = "@@ready";
+    constexpr QByteArrayView workerDone = "@@done ";
+
+    // a tool loading its common zones can take a while before it's ready
+    constexpr int workerStartTimeoutMs = 60 * 1000;
+    constexpr int workerIdleTimeoutMs = 10 * 60 * 1000;
+
+    QByteArray workerCommandLine(const QStringList& args)
+    {
+        QStringList quoted;
+        for (const QString& arg : args)
+            quoted << (arg.contains(' ') ? '"' + arg + '"' : arg);
+        return quoted.join(' ').toLocal8Bit() + '\n';
+    }
+}
+
+struct ProcessRunner::Worker
+{
+    struct Command
+    {
+        QStringList args;
+        std::function<void(int)> onFinish;
+        LineHandler onLine;
+    };
+
+    QFileInfo exe;
+    QProcess* process = nullptr;
+    LineRingBuffer output;
+    QTimer timer;       // start timeout until ready, idle timeout after
+    bool ready = false;
+    bool stopping = false; // asked to exit, queued commands wait for it to be gone
+
+    QQueue<Command> queue;
+    std::optional<Command> current;
+    ProcessSample sample;
+};
+
+void ProcessRunner::runInWorker(
+    const QFileInfo& exe,
+    const QStringList& args,
+    std::function<void(int)> onFinish,
+    LineHandler onLine)
+{
+    const QString key = exe.absoluteFilePath();
+    if (m_workerless.contains(key))
+    {
+        run(exe, args, onFinish, onLine);
+        return;
+    }
+
+    auto worker = m_workers.value(key);
+    if (!worker)
+    {
+        worker = startWorker(exe);
+        if (!worker)
+        {
+            run(exe, args, onFinish, onLine);
+            return;
+        }
+        m_workers.insert(key, worker);
+    }
+
+    worker->queue.enqueue({ args, std::move(onFinish), std::move(onLine) });
+    runNextWorkerCommand(worker);
+}
+
+std::shared_ptr<ProcessRunner::Worker> ProcessRunner::startWorker(const QFileInfo& exe)
+{
+    if (!exe.exists())
+    {
+        qCritical() << "Missing executable:" << exe.absoluteFilePath();
+        return nullptr;
+    }
+
+    auto worker = std::make_shared<Worker>();
+    worker->exe = exe;
+
+    auto* proc = new QProcess(this);
+    proc->setProgram(exe.absoluteFilePath());
+    proc->setArguments({ "-worker", "-unbuffered-io" });
+    proc->setWorkingDirectory(exe.absolutePath());
+    proc->setProcessChannelMode(QProcess::MergedChannels);
+    worker->process = proc;
+
+    const std::weak_ptr<Worker> weak = worker;
+
+    // lines belong to whichever command is running, the frame line hands over to the next
+    const auto consume = [this, weak](QByteArrayView line)
+    {
+        const auto worker = weak.lock();
+        if (!worker)
+            return false;
+
+        if (line == workerReady)
+        {
+            worker->ready = true;
+            worker->timer.start(workerIdleTimeoutMs);
+            qDebug() << worker->exe.fileName() << "worker is ready";
+            runNextWorkerCommand(worker);
+            return true;
+        }
+
+        if (!line.startsWith(workerDone) || !worker->current)
+            return false;
+
+        bool ok = false;
+        const int exitCode = line.sliced(workerDone.size()).toInt(&ok);
+
+        worker->sample.exitCode = ok ? exitCode : -1;
+        worker->sample.wallUs = m_telemetry.elapsedUs() - worker->sample.startUs;
+        m_telemetry.record(worker->sample);
+
+        // the callback may queue more commands or stop the workers, let the read finish first
+        const auto onFinish = std::move(worker->current->onFinish);
+        worker->current.reset();
+        if (onFinish)
+            QMetaObject::invokeMethod(this, [onFinish, code = worker->sample.exitCode]() { onFinish(code); }, Qt::QueuedConnection);
+
+        worker->timer.start(workerIdleTimeoutMs);
+        runNextWorkerCommand(worker);
+        return true;
+    };
+
+    const auto onLine = [weak](QByteArrayView line, qint64 receivedUs)
+    {
+        const auto worker = weak.lock();
+        if (worker && worker->current && worker->current->onLine)
+            worker->current->onLine(line, receivedUs);
+    };
+
+    connect(proc, &QProcess::readyRead, this, [this, weak, consume, onLine]()
+    {
+        if (const auto worker = weak.lock())
+            readOutputFromProcess(worker->process, worker->output, false, onLine, elapsedUs(), consume);
+    });
+
+    // holds the worker until its process is gone, stopped workers still finish their command
+    connect(proc, &QProcess::finished, this, [this, worker, consume, onLine](int code)
+    {
+        readOutputFromProcess(worker->process, worker->output, true, onLine, elapsedUs(), consume);
+        onWorkerLost(worker, QString("exited with code %1").arg(code));
+    });
+
+    connect(proc, &QProcess::errorOccurred, this, [this, weak](QProcess::ProcessError error)
+    {
+        const auto worker = weak.lock();
+        if (worker && error == QProcess::FailedToStart)
+            onWorkerLost(worker, "failed to start");
+    });
+
+    worker->timer.setSingleShot(true);
+    connect(&worker->timer, &QTimer::timeout, this, [this, weak]()
+    {
+        const auto worker = weak.lock();
+        if (!worker || worker->stopping)
+            return;
+
+        if (!worker->ready)
+        {
+            onWorkerLost(worker, "never reported ready");
+            return;
+        }
+
+        // idle for a while, give the memory back
+        if (!worker->current && worker->queue.isEmpty())
+        {
+            m_workers.remove(worker->exe.absoluteFilePath());
+            worker->stopping = true;
+            worker->process->closeWriteChannel();
+        }
+    });
+
+    qDebug() << "Starting" << exe.fileName() << "worker";
+    worker->timer.start(workerStartTimeoutMs);
+    proc->start();
+
+    return worker;
+}
+
+void ProcessRunner::runNextWorkerCommand(const std::shared_ptr<Worker>& worker)
+{
+    if (!worker->ready || worker->stopping || worker->current || worker->queue.isEmpty())
+        return;
+
+    worker->current = worker->queue.dequeue();
+    worker->timer.stop();
+
+    worker->sample = {};
+    worker->sample.name = worker->exe.fileName() + " (worker)";
+    worker->sample.arguments = worker->current->args;
+    worker->sample.lane = m_telemetry.acquireLane();
+    worker->sample.startUs = m_telemetry.elapsedUs();
+
+    worker->process->write(workerCommandLine(worker->current->args));
+}
+
+void ProcessRunner::onWorkerLost(const std::shared_ptr<Worker>& worker, const QString& reason)
+{
+    const QString key = worker->exe.absoluteFilePath();
+    if (m_workers.value(key) == worker)
+        m_workers.remove(key);
+
+    worker->timer.stop();
+
+    QQueue<Worker::Command> pending;
+    if (worker->current)
+    {
+        // the command may have half run, one-shot processes start it over
+        worker->sample.exitCode = -1;
+        worker->sample.wallUs = m_telemetry.elapsedUs() - worker->sample.startUs;
+        m_telemetry.record(worker->sample);
+        pending.enqueue(std::move(*worker->current));
+        worker->current.reset();
+    }
+    pending.append(worker->queue);
+    worker->queue.clear();
+
+    // a worker stopped before it got ready says nothing about whether the tool has a worker mode
+    if (!worker->ready && !worker->stopping)
+    {
+        qWarning() << worker->exe.fileName() << "worker" << reason << "- running it as one-shot processes from now on";
+        m_workerless.insert(key);
+    }
+    else if (!pending.isEmpty())
+    {
+        qWarning() << worker->exe.fileName() << "worker" << reason << "- rerunning its commands as one-shot processes";
+    }
+
+    if (worker->process->state() != QProcess::NotRunning)
+        worker->process->kill();
+    worker->process->deleteLater();
+
+    for (auto& command : pending)
+        run(worker->exe, command.args, std::move(command.onFinish), std::move(command.onLine));
+}
+
+void ProcessRunner::stopWorkers()
+{
+    const auto workers = m_workers.values();
+    m_workers.clear();
+
+    for (const auto& worker : workers)
+    {
+        worker->timer.stop();
+        worker->stopping = true;
+        worker->process->closeWriteChannel();
+    }
+}
@@ -2,6 +2,9 @@
 
 #include "Globals.h"
 
+#include "ProcessTelemetry.h"
+#include "Utils/LineRingBuffer.h"
+
 class ProcessRunner : public QObject
 {
     Q_OBJECT
@@ -9,11 +12,69 @@ class ProcessRunner : public QObject
 public:
     explicit ProcessRunner(QObject* parent = nullptr);
 
-    static void readOutputFromProcess(QProcess* process);
+    // Sees each output line without its level prefix before it gets logged, along with
+    // when it was read on the elapsedUs() clock. Lines read together share a time.
+    using LineHandler = std::function<void(QByteArrayView line, qint64 receivedUs)>;
+
+    // Logs the complete lines available on process, flush also logs an unterminated last line.
+    // Lines consume returns true for are neither passed to onLine nor logged.
+    static void readOutputFromProcess(
+        QProcess* process,
+        LineRingBuffer& buffer,
+        bool flush = false,
+        const LineHandler& onLine = {},
+        qint64 receivedUs = 0,
+        const std::function<bool(QByteArrayView)>& consume = {}
+    );
+
+    // The process deletes itself once it finished, null when the exe is missing
+    QPointer<QProcess> run(
+        const QFileInfo& exe,
+        const QStringList& args,
+        std::function<void(int)> onFinish = {},
+        LineHandler onLine = {}
+    );
+
+    // Kills process along with everything it started, it still reports finished
+    static void killProcessTree(QProcess* process);
 
-    void run(
+    // Runs args as a command of a long-lived "exe -worker" process, which keeps what it
+    // loaded between commands. The worker starts on first use and is reused by later
+    // calls for the same exe, commands queue up and run one at a time.
+    //
+    // Protocol, one line each way:
+    //   worker  -> "@@ready" once it accepts commands
+    //   runner  -> the command's arguments, space separated, quoted when they contain spaces
+    //   worker  -> the command's output, then "@@done <exit code>"
+    // Closing stdin asks the worker to exit. A tool that never gets ready, or dies,
+    // has its commands rerun as one-shot processes and isn't tried as a worker again.
+    // tools/ZonetoolStandIn speaks this protocol without the game.
+    void runInWorker(
         const QFileInfo& exe,
         const QStringList& args,
-        std::function<void(int)> onFinish = {}
+        std::function<void(int)> onFinish = {},
+        LineHandler onLine = {}
     );
+
+    // Lets every worker exit, the next command for a tool starts a fresh one
+    void stopWorkers();
+
+    // Every process run records its wall time, cpu time and peak working set here
+    ProcessTelemetry& telemetry() { return m_telemetry; }
+
+    // Monotonic, unlike the telemetry clock it never restarts
+    qint64 elapsedUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+private:
+    struct Worker;
+
+    std::shared_ptr<Worker> startWorker(const QFileInfo& exe);
+    void runNextWorkerCommand(const std::shared_ptr<Worker>& worker);
+    void onWorkerLost(const std::shared_ptr<Worker>& worker, const QString& reason);
+
+    QElapsedTimer m_clock;
+    ProcessTelemetry m_telemetry;
+
+    QHash<QString, std::shared_ptr<Worker>> m_workers;
+    QSet<QString> m_workerless; // tools that didn't speak the worker protocol
 };
\ No newline at end of file
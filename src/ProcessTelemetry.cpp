@@ -0,0 +1,145 @@
+#include "ProcessTelemetry.h"
+
+namespace
+{
+    QString formatDuration(qint64 us)
+    {
+        if (us < 0)
+            return "n/a";
+        return QString::number(us / 1000000.0, 'f', 2) + " s";
+    }
+
+    QString formatBytes(qint64 bytes)
+    {
+        if (bytes < 0)
+            return "n/a";
+        return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+    }
+}
+
+ProcessTelemetry::ProcessTelemetry()
+{
+    m_clock.start();
+}
+
+void ProcessTelemetry::reset()
+{
+    m_samples.clear();
+    m_lanes.clear();
+    m_clock.restart();
+}
+
+int ProcessTelemetry::acquireLane()
+{
+    for (int lane = 0; lane < m_lanes.size(); lane++)
+    {
+        if (!m_lanes[lane])
+        {
+            m_lanes[lane] = true;
+            return lane;
+        }
+    }
+
+    m_lanes << true;
+    return m_lanes.size() - 1;
+}
+
+void ProcessTelemetry::record(const ProcessSample& sample)
+{
+    if (sample.lane >= 0 && sample.lane < m_lanes.size())
+        m_lanes[sample.lane] = false;
+
+    m_samples << sample;
+}
+
+void ProcessTelemetry::logSummary(const QString& title) const
+{
+    if (m_samples.isEmpty())
+        return;
+
+    qsizetype nameWidth = 7;
+    for (const auto& sample : m_samples)
+        nameWidth = std::max(nameWidth, sample.name.size());
+
+    const auto row = [nameWidth](const QString& name, const QString& wall, const QString& cpu, const QString& peak, const QString& exit)
+    {
+        return QString("%1  %2  %3  %4  %5")
+            .arg(name, -int(nameWidth))
+            .arg(wall, 10)
+            .arg(cpu, 10)
+            .arg(peak, 10)
+            .arg(exit, 5);
+    };
+
+    QStringList lines;
+    lines << title;
+    lines << row("Process", "Wall", "CPU", "Peak RAM", "Exit");
+
+    qint64 cpuTotal = 0;
+    qint64 peakMax = -1;
+    qint64 firstStart = m_samples.first().startUs;
+    qint64 lastEnd = 0;
+    for (const auto& sample : m_samples)
+    {
+        const qint64 cpu = sample.userCpuUs < 0 ? -1 : sample.userCpuUs + sample.kernelCpuUs;
+        if (cpu > 0)
+            cpuTotal += cpu;
+        peakMax = std::max(peakMax, sample.peakWorkingSet);
+        firstStart = std::min(firstStart, sample.startUs);
+        lastEnd = std::max(lastEnd, sample.startUs + sample.wallUs);
+
+        lines << row(sample.name, formatDuration(sample.wallUs), formatDuration(cpu), formatBytes(sample.peakWorkingSet), QString::number(sample.exitCode));
+    }
+
+    // wall total spans first start to last exit, parallel steps overlap
+    lines << row("Total", formatDuration(lastEnd - firstStart), formatDuration(peakMax < 0 ? -1 : cpuTotal), formatBytes(peakMax), "");
+
+    qInfo().noquote() << lines.join('\n');
+}
+
+bool ProcessTelemetry::writeChromeTrace(const QString& path) const
+{
+    QJsonArray events;
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    for (const auto& sample : m_samples)
+    {
+        QJsonObject args;
+        args["arguments"] = sample.arguments.join(' ');
+        args["exitCode"] = sample.exitCode;
+        if (sample.userCpuUs >= 0)
+        {
+            args["userCpuMs"] = sample.userCpuUs / 1000.0;
+            args["kernelCpuMs"] = sample.kernelCpuUs / 1000.0;
+        }
+        if (sample.peakWorkingSet >= 0)
+            args["peakWorkingSetMB"] = sample.peakWorkingSet / (1024.0 * 1024.0);
+
+        QJsonObject event;
+        event["name"] = sample.name;
+        event["cat"] = "process";
+        event["ph"] = "X";
+        event["ts"] = sample.startUs;
+        event["dur"] = sample.wallUs;
+        event["pid"] = pid;
+        event["tid"] = sample.lane;
+        event["args"] = args;
+        events << event;
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Failed to write process trace" << path;
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Globals.h"
+
+// Resource usage of the child processes a pipeline ran, for telling which step
+// an export or map build spends its time in
+struct ProcessSample
+{
+    QString name;               // executable file name
+    QStringList arguments;
+    int exitCode = 0;
+    int lane = 0;               // processes running side by side get different lanes
+    qint64 startUs = 0;         // since the recording started
+    qint64 wallUs = 0;
+    qint64 userCpuUs = -1;      // -1 where the platform doesn't report it
+    qint64 kernelCpuUs = -1;
+    qint64 peakWorkingSet = -1; // bytes
+};
+
+class ProcessTelemetry
+{
+public:
+    ProcessTelemetry();
+
+    // Forgets what was recorded and restarts the clock
+    void reset();
+
+    qint64 elapsedUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+    // Lowest lane no running process holds
+    int acquireLane();
+    void record(const ProcessSample& sample);
+
+    const QVector<ProcessSample>& samples() const { return m_samples; }
+
+    // One row per process and a total, in the order they finished
+    void logSummary(const QString& title) const;
+
+    // Chrome trace event format, opens in chrome://tracing or ui.perfetto.dev
+    bool writeChromeTrace(const QString& path) const;
+
+private:
+    QElapsedTimer m_clock;
+    QVector<ProcessSample> m_samples;
+    QVector<bool> m_lanes;
+};
@@ -36,6 +36,8 @@ SettingsDialog::SettingsDialog(QWidget* parent) :
     ui->setupUi(this);
 
     ui->AuroraThemeCheckBox->setChecked(savedThemeValue.toBool());
+    ui->KeepZonetoolRunningCheckBox->setChecked(settings.value("KeepZonetoolRunning", false).toBool());
+    ui->CompressOldLogsCheckBox->setChecked(settings.value("CompressOldLogs", false).toBool());
 
     connect(this, &QDialog::rejected, this, &SettingsDialog::handleDialogRejected);
     connect(this, &QDialog::accepted, this, &SettingsDialog::handleDialogAccepted);
@@ -89,6 +91,10 @@ void SettingsDialog::handleDialogAccepted()
     Globals.pathIW5 = iw5Path;
     Globals.h1Executable = h1Executable;
 
+    QSettings settings;
+    settings.setValue("KeepZonetoolRunning", ui->KeepZonetoolRunningCheckBox->isChecked());
+    settings.setValue("CompressOldLogs", ui->CompressOldLogsCheckBox->isChecked());
+
     saveGlobalsToJson(this);
 }
 
@@ -12,8 +12,7 @@ namespace Funcs
             case GameType::IW5: return Globals.pathIW5;
             case GameType::H1: return Globals.pathH1;
             default:
-                __debugbreak();
-                return "";
+                qFatal("getGamePath: unknown game type %d", static_cast<int>(gameType));
             }
         };
 
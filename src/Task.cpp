@@ -0,0 +1,89 @@
+#include "Task.h"
+
+void CancellationToken::throwIfCancelled() const
+{
+    if (isCancelled())
+        throw TaskCancelled();
+}
+
+int CancellationToken::onCancel(std::function<void()> callback) const
+{
+    if (!m_state)
+        return -1;
+
+    if (m_state->cancelled)
+    {
+        callback();
+        return -1;
+    }
+
+    const int id = m_state->nextId++;
+    m_state->callbacks.insert(id, std::move(callback));
+    return id;
+}
+
+void CancellationToken::removeCallback(int id) const
+{
+    if (m_state)
+        m_state->callbacks.remove(id);
+}
+
+CancellationSource::CancellationSource()
+{
+    m_token.m_state = std::make_shared<CancellationToken::State>();
+}
+
+CancellationToken CancellationSource::token() const
+{
+    return m_token;
+}
+
+void CancellationSource::cancel()
+{
+    auto& state = *m_token.m_state;
+    if (state.cancelled.exchange(true))
+        return;
+
+    // callbacks may unregister others while they run
+    const auto callbacks = std::exchange(state.callbacks, {});
+    for (const auto& callback : callbacks)
+        callback();
+}
+
+Task<int> runProcess(
+    ProcessRunner& runner,
+    QFileInfo exe,
+    QStringList args,
+    CancellationToken token,
+    ProcessRunner::LineHandler onLine)
+{
+    token.throwIfCancelled();
+
+    QPointer<QProcess> process;
+    const int cancelId = token.onCancel([&process]()
+    {
+        ProcessRunner::killProcessTree(process);
+    });
+    const auto unregister = qScopeGuard([&token, cancelId]()
+    {
+        token.removeCallback(cancelId);
+    });
+
+    auto finished = fromCallback<int>([&](std::function<void(int)> done)
+    {
+        process = runner.run(exe, args, std::move(done), std::move(onLine));
+    });
+    const int exitCode = co_await finished;
+
+    token.throwIfCancelled();
+    co_return exitCode;
+}
+
+Task<bool> copyFileAsync(QString source, QString destination, CancellationToken token)
+{
+    auto copy = runInPool([source, destination]()
+    {
+        return QtUtils::copyFile(source, destination);
+    }, token);
+    co_return co_await copy;
+}
@@ -0,0 +1,445 @@
+#pragma once
+
+#include "Globals.h"
+
+#include "ProcessRunner.h"
+
+#include <QtConcurrent/QtConcurrent>
+
+#include <coroutine>
+#include <exception>
+
+// Coroutine pipelines for the ui thread. A Task<T> starts when it's awaited, or when
+// start() detaches it, and always resumes on the ui thread: processes report back through
+// the event loop and thread pool work through a QFutureWatcher.
+
+// Thrown out of an await once the pipeline's token is cancelled
+struct TaskCancelled : std::exception
+{
+    const char* what() const noexcept override { return "task cancelled"; }
+};
+
+class CancellationToken
+{
+public:
+    // A default token never gets cancelled
+    CancellationToken() = default;
+
+    // Safe to poll from thread pool work
+    bool isCancelled() const { return m_state && m_state->cancelled; }
+    void throwIfCancelled() const;
+
+    // Runs callback on cancellation, right away when already cancelled. Ui thread only.
+    int onCancel(std::function<void()> callback) const;
+    void removeCallback(int id) const;
+
+private:
+    friend class CancellationSource;
+
+    struct State
+    {
+        std::atomic<bool> cancelled = false;
+        int nextId = 0;
+        QMap<int, std::function<void()>> callbacks;
+    };
+
+    std::shared_ptr<State> m_state;
+};
+
+class CancellationSource
+{
+public:
+    CancellationSource();
+
+    CancellationToken token() const;
+    bool isCancelled() const { return m_token.isCancelled(); }
+
+    // Runs the registered callbacks, awaits throw TaskCancelled once they resume
+    void cancel();
+
+private:
+    CancellationToken m_token;
+};
+
+template <typename T = void>
+class Task;
+
+namespace TaskDetail
+{
+    struct PromiseBase
+    {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept
+            {
+                const auto continuation = handle.promise().continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    template <typename T>
+    struct Promise : PromiseBase
+    {
+        std::optional<T> value;
+
+        Task<T> get_return_object();
+
+        template <typename U>
+        void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+        T result()
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+            return std::move(*value);
+        }
+    };
+
+    template <>
+    struct Promise<void> : PromiseBase
+    {
+        Task<void> get_return_object();
+
+        void return_void() {}
+
+        void result()
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+    };
+
+    // Frame of a started task, frees itself when the task is done
+    struct Detached
+    {
+        struct promise_type
+        {
+            Detached get_return_object() const noexcept { return {}; }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+    };
+
+    template <typename T>
+    Detached runDetached(Task<T> task, std::function<void(std::exception_ptr)> onDone)
+    {
+        std::exception_ptr error;
+        try
+        {
+            co_await task;
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        if (onDone)
+            onDone(error);
+    }
+}
+
+template <typename T>
+class [[nodiscard]] Task
+{
+public:
+    using promise_type = TaskDetail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle handle) : m_handle(handle) {}
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_handle)
+                m_handle.destroy();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        m_handle.promise().continuation = awaiting;
+        return m_handle;
+    }
+
+    T await_resume() { return m_handle.promise().result(); }
+
+    // Runs the task without anyone awaiting it, onDone gets what it threw, if anything
+    void start(std::function<void(std::exception_ptr)> onDone = {}) &&
+    {
+        TaskDetail::runDetached(std::move(*this), std::move(onDone));
+    }
+
+private:
+    Handle m_handle;
+};
+
+namespace TaskDetail
+{
+    template <typename T>
+    Task<T> Promise<T>::get_return_object()
+    {
+        return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+    }
+
+    inline Task<void> Promise<void>::get_return_object()
+    {
+        return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+    }
+
+    template <typename T>
+    Task<void> storeResult(Task<T> task, std::optional<T>& slot)
+    {
+        slot.emplace(co_await task);
+    }
+
+    // Starts every task and resumes the awaiting coroutine once all of them are done
+    class AllDone
+    {
+    public:
+        explicit AllDone(std::vector<Task<void>> tasks) : m_tasks(std::move(tasks)) {}
+
+        bool await_ready() const noexcept { return m_tasks.empty(); }
+
+        bool await_suspend(std::coroutine_handle<> awaiting)
+        {
+            auto state = m_state;
+            state->remaining = static_cast<int>(m_tasks.size());
+
+            for (auto& task : m_tasks)
+            {
+                std::move(task).start([state](std::exception_ptr error)
+                {
+                    if (error && !state->error)
+                        state->error = error;
+
+                    // a task that finishes while the rest are still starting must not resume the caller
+                    if (--state->remaining == 0 && state->waiting)
+                        state->waiting.resume();
+                });
+            }
+
+            if (state->remaining == 0)
+                return false;
+
+            state->waiting = awaiting;
+            return true;
+        }
+
+        void await_resume() const
+        {
+            if (m_state->error)
+                std::rethrow_exception(m_state->error);
+        }
+
+    private:
+        struct State
+        {
+            int remaining = 0;
+            std::coroutine_handle<> waiting;
+            std::exception_ptr error;
+        };
+
+        std::vector<Task<void>> m_tasks;
+        std::shared_ptr<State> m_state = std::make_shared<State>();
+    };
+}
+
+// Runs tasks side by side. Rethrows the first failure, but only once every task is done.
+inline Task<void> whenAll(std::vector<Task<void>> tasks)
+{
+    TaskDetail::AllDone allDone(std::move(tasks));
+    co_await allDone;
+}
+
+template <typename T>
+Task<QList<T>> whenAll(std::vector<Task<T>> tasks)
+{
+    std::vector<std::optional<T>> slots(tasks.size());
+
+    std::vector<Task<void>> stored;
+    stored.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++)
+        stored.push_back(TaskDetail::storeResult(std::move(tasks[i]), slots[i]));
+
+    TaskDetail::AllDone allDone(std::move(stored));
+    co_await allDone;
+
+    QList<T> results;
+    results.reserve(static_cast<qsizetype>(slots.size()));
+    for (auto& slot : slots)
+        results << std::move(*slot);
+    co_return results;
+}
+
+// Runs tasks of different types side by side, gives their results in order
+template <typename... Ts>
+Task<std::tuple<Ts...>> whenAll(Task<Ts>... tasks)
+{
+    std::tuple<std::optional<Ts>...> slots;
+
+    std::vector<Task<void>> stored;
+    std::apply([&](auto&... slot)
+    {
+        (stored.push_back(TaskDetail::storeResult(std::move(tasks), slot)), ...);
+    }, slots);
+
+    TaskDetail::AllDone allDone(std::move(stored));
+    co_await allDone;
+
+    co_return std::apply([](auto&... slot)
+    {
+        return std::tuple<Ts...>(std::move(*slot)...);
+    }, slots);
+}
+
+// Runs exe through runner, gives its exit code. Cancelling kills its process tree.
+Task<int> runProcess(
+    ProcessRunner& runner,
+    QFileInfo exe,
+    QStringList args,
+    CancellationToken token = {},
+    ProcessRunner::LineHandler onLine = {}
+);
+
+// Adapts a callback API, start gets the function to pass its result to
+template <typename T>
+Task<T> fromCallback(std::function<void(std::function<void(T)>)> start, CancellationToken token = {})
+{
+    struct State
+    {
+        std::optional<T> result;
+        std::coroutine_handle<> waiting;
+    };
+
+    struct Awaiter
+    {
+        std::function<void(std::function<void(T)>)> start;
+        std::shared_ptr<State> state = std::make_shared<State>();
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> awaiting)
+        {
+            // callbacks that run right away, or more than once, can't resume the caller twice
+            start([state = state](T value)
+            {
+                if (state->result)
+                    return;
+                state->result.emplace(std::move(value));
+                if (const auto waiting = std::exchange(state->waiting, {}))
+                    waiting.resume();
+            });
+
+            if (state->result)
+                return false;
+
+            state->waiting = awaiting;
+            return true;
+        }
+
+        T await_resume() { return std::move(*state->result); }
+    };
+
+    token.throwIfCancelled();
+
+    Awaiter awaiter{ std::move(start) };
+    T result = co_await awaiter;
+
+    token.throwIfCancelled();
+    co_return result;
+}
+
+// Runs function on the global thread pool, resumes on the ui thread with its result.
+// Long work should poll token itself, it's only checked before and after.
+template <typename F>
+auto runInPool(F function, CancellationToken token = {}) -> Task<std::invoke_result_t<F>>
+{
+    using R = std::invoke_result_t<F>;
+
+    struct Outcome
+    {
+        std::conditional_t<std::is_void_v<R>, bool, std::optional<R>> value{};
+        std::exception_ptr error;
+    };
+
+    struct Awaiter
+    {
+        F function;
+        std::shared_ptr<Outcome> outcome = std::make_shared<Outcome>();
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> awaiting)
+        {
+            auto* watcher = new QFutureWatcher<void>();
+            QObject::connect(watcher, &QFutureWatcher<void>::finished, watcher, [watcher, awaiting]()
+            {
+                watcher->deleteLater();
+                awaiting.resume();
+            });
+
+            watcher->setFuture(QtConcurrent::run([work = std::move(function), outcome = outcome]() mutable
+            {
+                try
+                {
+                    if constexpr (std::is_void_v<R>)
+                        work();
+                    else
+                        outcome->value.emplace(work());
+                }
+                catch (...)
+                {
+                    outcome->error = std::current_exception();
+                }
+            }));
+        }
+
+        void await_resume() const
+        {
+            if (outcome->error)
+                std::rethrow_exception(outcome->error);
+        }
+    };
+
+    token.throwIfCancelled();
+
+    Awaiter awaiter{ std::move(function) };
+    const auto outcome = awaiter.outcome;
+    co_await awaiter;
+
+    token.throwIfCancelled();
+
+    if constexpr (!std::is_void_v<R>)
+        co_return std::move(*outcome->value);
+}
+
+// File stage on the thread pool
+Task<bool> copyFileAsync(QString source, QString destination, CancellationToken token = {});
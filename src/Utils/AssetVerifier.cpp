@@ -0,0 +1,165 @@
+#include "AssetVerifier.h"
+#include "CSV.h"
+
+#include <QtConcurrent/QtConcurrent>
+
+namespace
+{
+    struct AssetPathRule
+    {
+        QString prefix;
+        QString suffix;
+    };
+
+    // Where zonetool expects each asset type on disk, relative to a search root.
+    // Types not listed here are counted as skipped rather than guessed at.
+    const QHash<QString, QList<AssetPathRule>>& assetPathRules()
+    {
+        static const QHash<QString, QList<AssetPathRule>> rules =
+        {
+            { "rawfile",       { { "", "" } } },
+            { "stringtable",   { { "", "" } } },
+            { "aipaths",       { { "", "" }, { "", ".aipaths" }, { "", ".aipaths.json" } } },
+            { "material",      { { "materials/", ".json" } } },
+            { "clut",          { { "clut/", ".clut" } } },
+            { "com_map",       { { "", ".commap" }, { "", ".commap.json" } } },
+            { "fx_map",        { { "", ".fxmap" }, { "", ".fxmap.json" } } },
+            { "gfx_map",       { { "", ".gfxmap" }, { "", ".gfxmap.json" } } },
+            { "map_ents",      { { "", ".ents" }, { "", ".ents.json" } } },
+            { "glass_map",     { { "", ".glassmap" }, { "", ".glassmap.json" } } },
+            { "phys_worldmap", { { "", ".physmap" }, { "", ".physmap.json" } } },
+            { "col_map_sp",    { { "", ".colmap" }, { "", ".colmap.json" } } },
+            { "col_map_mp",    { { "", ".colmap" }, { "", ".colmap.json" } } },
+        };
+        return rules;
+    }
+
+    // Keeps the case, directories are listed as they are on disk
+    QString normalizePath(const QString& path)
+    {
+        QString result = path;
+        result.replace('\\', '/');
+        while (result.endsWith('/'))
+            result.chop(1);
+        return result;
+    }
+
+    struct Candidate
+    {
+        QString directory; // as on disk
+        QString fileKey;   // lowercased, zonetool finds files regardless of case
+    };
+
+    struct PendingAsset
+    {
+        QString label;
+        QVector<Candidate> candidates; // any of them satisfies the row
+    };
+}
+
+AssetVerifyResult verifyZoneSourceAssets(const QString& zone, GameType gameType)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    AssetVerifyResult result{};
+
+    const QString gamePath = Funcs::Shared::getGamePath(gameType);
+    const QString csvPath = gamePath + "/zone_source/" + zone + ".csv";
+
+    CSV csv{};
+    csv.readFile(csvPath);
+
+    QStringList roots;
+    roots << normalizePath(gamePath + "/zonetool/" + zone);
+
+    // addpaths rows can appear anywhere, so collect them before resolving assets
+    for (const auto& row : csv.rows())
+    {
+        if (row.size() < 2 || row[0].trimmed() != "addpaths")
+            continue;
+
+        const QString addPath = row[1].trimmed();
+        roots << normalizePath(QDir::isAbsolutePath(addPath) ? addPath : gamePath + "/" + addPath);
+    }
+
+    const auto& rules = assetPathRules();
+
+    QVector<PendingAsset> pending;
+    QSet<QString> directories;
+
+    for (const auto& row : csv.rows())
+    {
+        if (row.size() < 2)
+            continue;
+
+        const QString type = row[0].trimmed();
+        const QString name = row[1].trimmed();
+
+        // comments, disabled rows and references to assets from other zones need no file
+        if (type.isEmpty() || type.startsWith("//") || type.startsWith('#'))
+            continue;
+        if (type == "addpaths" || type == "ignore")
+            continue;
+        if (name.isEmpty())
+            continue;
+
+        const auto rule = rules.constFind(type);
+        if (rule == rules.constEnd())
+        {
+            result.skippedCount++;
+            result.skippedTypes[type]++;
+            continue;
+        }
+
+        PendingAsset asset{};
+        asset.label = type + "," + name;
+
+        for (const auto& root : roots)
+        {
+            for (const auto& pathRule : *rule)
+            {
+                const QString candidate = normalizePath(root + "/" + pathRule.prefix + name + pathRule.suffix);
+                const qsizetype slash = candidate.lastIndexOf('/');
+                directories.insert(candidate.left(slash));
+                asset.candidates.push_back({ candidate.left(slash), candidate.mid(slash + 1).toLower() });
+            }
+        }
+
+        pending.push_back(asset);
+    }
+
+    // list every directory once, spread over the thread pool, instead of one stat per candidate
+    const QStringList directoryList = directories.values();
+    const QList<QSet<QString>> listings = QtConcurrent::blockingMapped(directoryList, [](const QString& dir)
+    {
+        QSet<QString> names;
+        const QStringList entries = QDir(dir).entryList(QDir::Files | QDir::NoDotAndDotDot);
+        names.reserve(entries.size());
+        for (const auto& entry : entries)
+            names.insert(entry.toLower());
+        return names;
+    });
+
+    QHash<QString, QSet<QString>> directoryCache;
+    directoryCache.reserve(directoryList.size());
+    for (qsizetype i = 0; i < directoryList.size(); i++)
+        directoryCache.insert(directoryList[i], listings[i]);
+
+    for (const auto& asset : pending)
+    {
+        result.checkedCount++;
+
+        const bool found = std::any_of(asset.candidates.cbegin(), asset.candidates.cend(), [&](const Candidate& candidate)
+        {
+            const auto listing = directoryCache.constFind(candidate.directory);
+            return listing != directoryCache.constEnd() && listing->contains(candidate.fileKey);
+        });
+
+        if (!found)
+            result.missing << asset.label;
+    }
+
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
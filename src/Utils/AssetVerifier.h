@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+#include "../Shared.h"
+
+struct AssetVerifyResult
+{
+	int checkedCount = 0;
+	int skippedCount = 0; // asset types we don't know the on-disk layout of
+	QMap<QString, int> skippedTypes; // how many rows of each of those types went unchecked
+	QStringList missing;  // "type,name" for every row that could not be resolved
+	qint64 elapsedMs = 0;
+
+	bool ok() const { return missing.isEmpty(); }
+};
+
+// Checks that every row of zone_source/<zone>.csv resolves to a file in zonetool/<zone>
+// or one of the csv's addpaths folders, before zonetool gets to spend minutes on the build.
+AssetVerifyResult verifyZoneSourceAssets(const QString& zone, GameType gameType);
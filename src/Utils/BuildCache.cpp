@@ -0,0 +1,216 @@
+#include "BuildCache.h"
+#include "QTUtils.h"
+
+namespace
+{
+    QByteArray hashFile(const QString& path)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+            return {};
+
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(&file);
+        return hash.result().toHex();
+    }
+}
+
+BuildCache::BuildCache(const QString& root, qint64 maxSize)
+    : m_root(root), m_maxSize(maxSize)
+{
+}
+
+QString BuildCache::key(
+    const QFileInfo& exe,
+    const QStringList& args,
+    const QStringList& inputFiles,
+    const QStringList& inputTrees) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    // a different tool build can produce different outputs
+    hash.addData(exe.absoluteFilePath().toUtf8());
+    hash.addData(QByteArray::number(exe.size()));
+    hash.addData(QByteArray::number(exe.lastModified().toMSecsSinceEpoch()));
+
+    for (const QString& arg : args)
+    {
+        hash.addData(arg.toUtf8());
+        hash.addData(QByteArrayView("\0", 1));
+    }
+
+    for (const QString& input : inputFiles)
+    {
+        hash.addData(input.toUtf8());
+        hash.addData(hashFile(input));
+    }
+
+    for (const QString& tree : inputTrees)
+    {
+        QStringList files;
+        QDirIterator it(tree, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+            files << it.next();
+        files.sort();
+
+        for (const QString& file : files)
+        {
+            const QFileInfo info(file);
+            hash.addData(file.toUtf8());
+            hash.addData(QByteArray::number(info.size()));
+            hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+        }
+    }
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+bool BuildCache::restore(const QString& key) const
+{
+    QFile file(stepPath(key));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    const QJsonArray outputs = QJsonDocument::fromJson(file.readAll()).object()["outputs"].toArray();
+    file.close();
+
+    if (outputs.isEmpty())
+        return false;
+
+    // all or nothing, a half restored step is worse than running it
+    for (const auto& value : outputs)
+    {
+        if (!QFile::exists(objectPath(value.toObject()["object"].toString())))
+            return false;
+    }
+
+    for (const auto& value : outputs)
+    {
+        const QJsonObject output = value.toObject();
+        const QString path = output["path"].toString();
+        if (!QtUtils::copyFile(objectPath(output["object"].toString()), path))
+            return false;
+
+        // later steps fingerprint trees by modification time, a restore has to look like the original run
+        QFile restored(path);
+        if (restored.open(QIODevice::ReadWrite))
+            restored.setFileTime(QDateTime::fromMSecsSinceEpoch(output["modified"].toInteger()), QFileDevice::FileModificationTime);
+    }
+
+    // restores count as use for pruning
+    QFile step(stepPath(key));
+    if (step.open(QIODevice::ReadWrite))
+        step.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return true;
+}
+
+void BuildCache::store(const QString& key, const QStringList& outputs)
+{
+    QJsonArray entries;
+
+    for (const QString& output : outputs)
+    {
+        if (!QFile::exists(output))
+            continue;
+
+        const QString object = QString::fromLatin1(hashFile(output));
+        if (object.isEmpty())
+            continue;
+
+        if (!QFile::exists(objectPath(object)) && !QtUtils::copyFile(output, objectPath(object)))
+            return;
+
+        QJsonObject entry;
+        entry["path"] = output;
+        entry["object"] = object;
+        entry["modified"] = QFileInfo(output).lastModified().toMSecsSinceEpoch();
+        entries.append(entry);
+    }
+
+    if (entries.isEmpty())
+        return;
+
+    QDir().mkpath(m_root + "/steps");
+
+    QFile file(stepPath(key));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+    {
+        qWarning() << "Failed to write build cache entry:" << file.fileName();
+        return;
+    }
+
+    QJsonObject root;
+    root["outputs"] = entries;
+    file.write(QJsonDocument(root).toJson());
+    file.close();
+
+    prune();
+}
+
+void BuildCache::prune()
+{
+    QDir objectsDir(m_root + "/objects");
+    QDir stepsDir(m_root + "/steps");
+
+    QHash<QString, qint64> sizes;
+    qint64 total = 0;
+    for (const QFileInfo& object : objectsDir.entryInfoList(QDir::Files))
+    {
+        sizes.insert(object.fileName(), object.size());
+        total += object.size();
+    }
+
+    if (total <= m_maxSize)
+        return;
+
+    // every step is read once, dropping one only has to look at its own objects
+    struct Step
+    {
+        QString name;
+        QStringList objects;
+    };
+
+    std::vector<Step> steps;
+    QHash<QString, int> references;
+    for (const QFileInfo& info : stepsDir.entryInfoList(QDir::Files, QDir::Time | QDir::Reversed))
+    {
+        Step& step = steps.emplace_back();
+        step.name = info.fileName();
+
+        QFile file(info.filePath());
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            continue;
+
+        for (const auto& value : QJsonDocument::fromJson(file.readAll()).object()["outputs"].toArray())
+        {
+            const QString object = value.toObject()["object"].toString();
+            if (!step.objects.contains(object))
+            {
+                step.objects << object;
+                references[object]++;
+            }
+        }
+    }
+
+    // objects no step refers to, left by an interrupted store or an earlier prune
+    for (auto it = sizes.cbegin(); it != sizes.cend(); ++it)
+    {
+        if (!references.contains(it.key()) && objectsDir.remove(it.key()))
+            total -= it.value();
+    }
+
+    // oldest first, keep dropping steps until what's still referenced fits
+    for (const Step& step : steps)
+    {
+        if (total <= m_maxSize)
+            break;
+
+        stepsDir.remove(step.name);
+
+        for (const QString& object : step.objects)
+        {
+            if (--references[object] == 0 && objectsDir.remove(object))
+                total -= sizes.value(object);
+        }
+    }
+}
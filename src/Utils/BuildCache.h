@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+// Content addressed store for the outputs of external build steps. A step's key
+// hashes the tool, its arguments and its inputs, a hit copies the recorded outputs
+// back instead of running the tool again.
+//
+// <root>/objects/<sha1>    output contents, shared between steps
+// <root>/steps/<key>.json  which object goes to which output path
+class BuildCache
+{
+public:
+	explicit BuildCache(const QString& root, qint64 maxSize = qint64(4) << 30);
+
+	// inputFiles are hashed by content, missing ones count as empty. inputTrees are
+	// large folders fingerprinted by path, size and modification time of every file.
+	QString key(
+		const QFileInfo& exe,
+		const QStringList& args,
+		const QStringList& inputFiles,
+		const QStringList& inputTrees = {}
+	) const;
+
+	// Copies the outputs stored for key back in place, false when nothing complete is stored
+	bool restore(const QString& key) const;
+
+	// Stores whichever of outputs exist under key
+	void store(const QString& key, const QStringList& outputs);
+
+private:
+	QString objectPath(const QString& hash) const { return m_root + "/objects/" + hash; }
+	QString stepPath(const QString& key) const { return m_root + "/steps/" + key + ".json"; }
+
+	// Drops the least recently used steps until the objects fit in maxSize
+	void prune();
+
+	QString m_root;
+	qint64 m_maxSize;
+};
@@ -1,6 +1,8 @@
 #include "CSVGenerator.h"
 #include "MapEnts.h"
 #include "CSV.h"
+#include "GSCIndex.h"
+#include "../GameTraits.h"
 
 QSet<QString> parseCreateFxGsc(const QString& data)
 {
@@ -69,7 +71,8 @@ QMap<QString, QString> parseAnimatedModelScript(const QString& scriptText)
     return result;
 }
 
-void generateCSV(const QString& zone, const QString& destFolder, const bool isMpMap, GameType sourceGameType, GameType targetGameType)
+template <typename SourceGame>
+static void generateCSV(const QString& zone, const QString& destFolder, const bool isMpMap, GameType targetGameType, const bool pruneUnusedScripts)
 {
     if (!Funcs::Shared::isMap(zone, targetGameType) && !Funcs::Shared::isMapLoad(zone)) {
         qInfo() << "Could not generate csv for zone" << zone << "since it's not map/map load";
@@ -116,20 +119,8 @@ void generateCSV(const QString& zone, const QString& destFolder, const bool isMp
     addEmptyLine();
 
     // add assets path...
-    static const auto getAssetsPath = [sourceGameType]() -> QString {
-        QString assetsFolder = "zonetool_assets/";
-        switch (sourceGameType)
-        {
-        case IW3: return assetsFolder + "iw3";
-        case IW4: return assetsFolder + "iw4";
-        case IW5: return assetsFolder + "iw5";
-        default:
-            __debugbreak();
-            return "";
-        }
-    };
     addComment("Searches for game assets in the specified paths. If the third parameter is true, assets from these paths will be prioritized.");
-    addRow({ "addpaths", getAssetsPath(), "false"});
+    addRow({ "addpaths", SourceGame::assetsPath, "false"});
     addEmptyLine();
 
     const auto isMpZone = isMpMap ? true : zone.contains("_mp") || zone.contains("mp_") ? true : false;
@@ -416,7 +407,7 @@ void generateCSV(const QString& zone, const QString& destFolder, const bool isMp
         // how tf do we add the assets required by destructibles?? just iterating all is wasteful...
     }
 
-    const auto addAssetsLoaded = [&](const QString& assetType)
+    const auto addAssetsLoaded = [&](const QString& assetType, const std::function<bool(const QString&)>& filter = {})
     {
         std::unordered_set<QString> generated;
 
@@ -443,7 +434,7 @@ void generateCSV(const QString& zone, const QString& destFolder, const bool isMp
                 row.erase(row.begin() + 2);
             }
             
-            if (!generated.contains(row[1])) {
+            if (!generated.contains(row[1]) && (!filter || filter(row[1]))) {
                 addRow(row);
             }
         }
@@ -454,11 +445,35 @@ void generateCSV(const QString& zone, const QString& destFolder, const bool isMp
         }
     };
 
-    // add all rawfiles that were loaded in the zone
-    addAssetsLoaded("rawfile");
-    addAssetsLoaded("sound");
-    addAssetsLoaded("xmodel");
-    addAssetsLoaded("xanim");
+    // add all assets that were loaded in the zone, rawfiles first
+    if (pruneUnusedScripts) {
+        // the scripts added above are what the game loads directly, everything else has to be reachable from them
+        QStringList roots;
+        for (const auto& row : csv.rows()) {
+            if (row.count() > 1 && row[0] == "rawfile" && row[1].endsWith(".gsc", Qt::CaseInsensitive))
+                roots << row[1];
+        }
+
+        const auto index = GSC::SymbolIndex::build(rootDir);
+        const auto reachable = index.reachableFrom(roots);
+        qInfo() << "Indexed" << index.scripts().size() << "scripts," << reachable.size() << "reachable from the map scripts";
+
+        addAssetsLoaded("rawfile", [&](const QString& name) {
+            if (!name.endsWith(".gsc", Qt::CaseInsensitive) || reachable.contains(GSC::normalizeScriptPath(name)))
+                return true;
+
+            qInfo() << "Pruning unused script" << name.toUtf8().data();
+            return false;
+        });
+    }
+    else {
+        addAssetsLoaded("rawfile");
+    }
+
+    for (const auto& assetType : SourceGame::loadedAssetTypes) {
+        if (assetType != QLatin1String("rawfile"))
+            addAssetsLoaded(assetType);
+    }
 
     qInfo() << "Adding map assets...";
 
@@ -475,4 +490,11 @@ void generateCSV(const QString& zone, const QString& destFolder, const bool isMp
     addEmptyLine();
 
     save();
-}
\ No newline at end of file
+}
+
+void generateCSV(const QString& zone, const QString& destFolder, const bool isMpMap, GameType sourceGameType, GameType targetGameType, const bool pruneUnusedScripts)
+{
+    visitSourceGame(sourceGameType, [&](auto traits) {
+        generateCSV<decltype(traits)>(zone, destFolder, isMpMap, targetGameType, pruneUnusedScripts);
+    });
+}
@@ -4,4 +4,4 @@
 
 #include "../Shared.h"
 
-void generateCSV(const QString& zone, const QString& destFolder, const bool isMpMap, GameType sourceGameType, GameType targetGameType);
\ No newline at end of file
+void generateCSV(const QString& zone, const QString& destFolder, const bool isMpMap, GameType sourceGameType, GameType targetGameType, const bool pruneUnusedScripts = false);
\ No newline at end of file
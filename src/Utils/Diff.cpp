@@ -0,0 +1,206 @@
+#include "Diff.h"
+
+#include <vector>
+
+namespace Diff
+{
+    namespace
+    {
+        enum class Op
+        {
+            Equal,
+            Delete,
+            Insert
+        };
+
+        // a and b are the positions in before/after the line sits at
+        struct DiffLine
+        {
+            Op op;
+            int a;
+            int b;
+        };
+
+        // Myers' O(ND) diff of a[aBegin, aEnd) against b[bBegin, bEnd)
+        void diffRange(
+            const QList<QStringView>& a, int aBegin, int aEnd,
+            const QList<QStringView>& b, int bBegin, int bEnd,
+            std::vector<DiffLine>& script)
+        {
+            const int n = aEnd - aBegin;
+            const int m = bEnd - bBegin;
+            const int max = n + m;
+            const int offset = max + 1;
+
+            std::vector<int> v(2 * max + 3, 0);
+            std::vector<std::vector<int>> trace;
+
+            int steps = 0;
+            for (int d = 0; d <= max; d++)
+            {
+                trace.push_back(v);
+
+                bool done = false;
+                for (int k = -d; k <= d; k += 2)
+                {
+                    int x = (k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1]))
+                        ? v[offset + k + 1]
+                        : v[offset + k - 1] + 1;
+                    int y = x - k;
+
+                    while (x < n && y < m && a[aBegin + x] == b[bBegin + y])
+                    {
+                        x++;
+                        y++;
+                    }
+
+                    v[offset + k] = x;
+
+                    if (x >= n && y >= m)
+                    {
+                        done = true;
+                        break;
+                    }
+                }
+
+                if (done)
+                {
+                    steps = d;
+                    break;
+                }
+            }
+
+            // walk the trace back from the end to recover the edit script
+            std::vector<DiffLine> reversed;
+            int x = n;
+            int y = m;
+
+            for (int d = steps; d > 0; d--)
+            {
+                const auto& previous = trace[d];
+                const int k = x - y;
+                const int prevK = (k == -d || (k != d && previous[offset + k - 1] < previous[offset + k + 1]))
+                    ? k + 1
+                    : k - 1;
+                const int prevX = previous[offset + prevK];
+                const int prevY = prevX - prevK;
+
+                while (x > prevX && y > prevY)
+                {
+                    x--;
+                    y--;
+                    reversed.push_back({ Op::Equal, aBegin + x, bBegin + y });
+                }
+
+                if (x == prevX)
+                    reversed.push_back({ Op::Insert, aBegin + x, bBegin + y - 1 });
+                else
+                    reversed.push_back({ Op::Delete, aBegin + x - 1, bBegin + y });
+
+                x = prevX;
+                y = prevY;
+            }
+
+            while (x > 0 && y > 0)
+            {
+                x--;
+                y--;
+                reversed.push_back({ Op::Equal, aBegin + x, bBegin + y });
+            }
+
+            script.insert(script.end(), reversed.rbegin(), reversed.rend());
+        }
+    }
+
+    QString unified(const QString& name, QStringView before, QStringView after, int context)
+    {
+        if (before == after)
+            return {};
+
+        const QList<QStringView> a = before.split('\n');
+        const QList<QStringView> b = after.split('\n');
+
+        // conversions touch few lines, only diff what is between the common prefix and suffix
+        int prefix = 0;
+        while (prefix < a.size() && prefix < b.size() && a[prefix] == b[prefix])
+            prefix++;
+
+        int suffix = 0;
+        while (suffix < a.size() - prefix && suffix < b.size() - prefix &&
+            a[a.size() - 1 - suffix] == b[b.size() - 1 - suffix])
+            suffix++;
+
+        std::vector<DiffLine> script;
+        script.reserve(a.size() + b.size());
+
+        for (int i = 0; i < prefix; i++)
+            script.push_back({ Op::Equal, i, i });
+
+        diffRange(a, prefix, static_cast<int>(a.size()) - suffix, b, prefix, static_cast<int>(b.size()) - suffix, script);
+
+        for (int i = suffix; i > 0; i--)
+            script.push_back({ Op::Equal, static_cast<int>(a.size()) - i, static_cast<int>(b.size()) - i });
+
+        QString output;
+        output += "--- a/" + name + "\n";
+        output += "+++ b/" + name + "\n";
+
+        const int size = static_cast<int>(script.size());
+        int i = 0;
+
+        while (i < size)
+        {
+            if (script[i].op == Op::Equal)
+            {
+                i++;
+                continue;
+            }
+
+            // grow the hunk while changes are close enough to share context
+            const int hunkStart = std::max(0, i - context);
+            int lastChange = i;
+            int j = i;
+            while (j < size && j - lastChange <= 2 * context)
+            {
+                if (script[j].op != Op::Equal)
+                    lastChange = j;
+                j++;
+            }
+            const int hunkEnd = std::min(size, lastChange + context + 1);
+
+            int aCount = 0;
+            int bCount = 0;
+            QString body;
+
+            for (int h = hunkStart; h < hunkEnd; h++)
+            {
+                const auto& line = script[h];
+                switch (line.op)
+                {
+                case Op::Equal:
+                    body += " " + a[line.a].toString() + "\n";
+                    aCount++;
+                    bCount++;
+                    break;
+                case Op::Delete:
+                    body += "-" + a[line.a].toString() + "\n";
+                    aCount++;
+                    break;
+                case Op::Insert:
+                    body += "+" + b[line.b].toString() + "\n";
+                    bCount++;
+                    break;
+                }
+            }
+
+            output += QString("@@ -%1,%2 +%3,%4 @@\n")
+                .arg(script[hunkStart].a + 1).arg(aCount)
+                .arg(script[hunkStart].b + 1).arg(bCount);
+            output += body;
+
+            i = hunkEnd;
+        }
+
+        return output;
+    }
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+namespace Diff
+{
+	// Line based unified diff of before/after, empty when they are equal
+	QString unified(const QString& name, QStringView before, QStringView after, int context = 3);
+}
@@ -1,370 +1,676 @@
 #include "GSC.h"
 
 #include "QTUtils.h"
+#include "GSCParser.h"
+#include "GSCRules.h"
+#include "GSCMinify.h"
+#include "Diff.h"
 
-struct FunctionMapping
+#include <QtConcurrent/QtConcurrent>
+
+// How often each rule fired, reported by dry runs
+using RuleHits = QHash<QString, int>;
+
+struct TextEdit
 {
-    QString oldName;
-    QString newName;
-    int minArgs = -1;
-    std::function<QString(const QStringList&)> transformer;
+    int start;
+    int end;
+    QString text;
 };
 
-struct InsertionRule
+
+//-----------------------------------------------------
+// Apply sorted, non-overlapping edits to a source range
+//-----------------------------------------------------
+static QString ApplyEdits(
+    QStringView source,
+    int rangeStart,
+    int rangeEnd,
+    QVector<TextEdit> edits)
 {
-    QString afterCall;
-    QString insertCode;
-};
+    std::stable_sort(edits.begin(), edits.end(), [](const TextEdit& a, const TextEdit& b)
+    {
+        return a.start < b.start;
+    });
+
+    // size the output exactly so it is allocated once
+    qsizetype outputSize = rangeEnd - rangeStart;
+    int pos = rangeStart;
+
+    for (const auto& edit : edits)
+    {
+        if (edit.start < pos)
+            continue;
+        outputSize += edit.text.size() - (edit.end - edit.start);
+        pos = edit.end;
+    }
+
+    QString output;
+    output.reserve(outputSize);
 
-using RemovalMap = QHash<QString, QSet<QString>>;
-using InsertionMap = QHash<QString, QVector<InsertionRule>>;
-using MappingMap = QHash<QString, FunctionMapping>;
+    pos = rangeStart;
 
+    for (const auto& edit : edits)
+    {
+        if (edit.start < pos)
+            continue; // overlaps an earlier edit
+
+        output += source.mid(pos, edit.start - pos);
+        output += edit.text;
+        pos = edit.end;
+    }
+
+    output += source.mid(pos, rangeEnd - pos);
+
+    return output;
+}
 
 //-----------------------------------------------------
-// Parse full function body using brace matching
+// Same as ApplyEdits over the whole file, written
+// straight into the UTF-8 output. source is input
+// decoded, for ASCII scripts their offsets are the
+// same and untouched spans are copied byte for byte.
 //-----------------------------------------------------
-static int FindFunctionEnd(const QString& content, int bodyStart)
+static QByteArray ApplyEditsUtf8(
+    const QByteArray& input,
+    QStringView source,
+    QVector<TextEdit> edits)
 {
-    int depth = 1;
+    const bool isAscii = input.size() == source.size() &&
+        std::all_of(input.cbegin(), input.cend(), [](char c) { return static_cast<uchar>(c) < 0x80; });
 
-    for (int i = bodyStart; i < content.size(); i++)
+    if (!isAscii)
+        return ApplyEdits(source, 0, static_cast<int>(source.size()), std::move(edits)).toUtf8();
+
+    std::stable_sort(edits.begin(), edits.end(), [](const TextEdit& a, const TextEdit& b)
     {
-        switch (content[i].unicode())
-        {
-        case '{': depth++; break;
-        case '}': depth--; break;
-        }
+        return a.start < b.start;
+    });
+
+    // encode the replacements once, they also size the output exactly
+    QVector<QByteArray> replacements(edits.size());
+    qsizetype outputSize = input.size();
+    int pos = 0;
+
+    for (qsizetype i = 0; i < edits.size(); i++)
+    {
+        const auto& edit = edits[i];
+        if (edit.start < pos)
+            continue;
+        replacements[i] = edit.text.toUtf8();
+        outputSize += replacements[i].size() - (edit.end - edit.start);
+        pos = edit.end;
+    }
+
+    QByteArray output;
+    output.reserve(outputSize);
 
-        if (depth == 0)
-            return i + 1;
+    pos = 0;
+
+    for (qsizetype i = 0; i < edits.size(); i++)
+    {
+        const auto& edit = edits[i];
+        if (edit.start < pos)
+            continue; // overlaps an earlier edit
+
+        output.append(input.constData() + pos, edit.start - pos);
+        output.append(replacements[i]);
+        pos = edit.end;
     }
 
-    return content.size();
+    output.append(input.constData() + pos, input.size() - pos);
+
+    return output;
 }
 
 
 //-----------------------------------------------------
-// Process individual function block
+// Line helpers for inserting and removing statements
 //-----------------------------------------------------
-static QString ProcessFunctionBlock(
-    const QString& functionName,
-    QStringView block,
-    const RemovalMap& removalRules,
-    const InsertionMap& insertionRules)
+static int LineStart(QStringView source, int pos)
 {
-    QStringList lines = block.toString().split('\n');
-    QStringList output;
+    while (pos > 0 && source[pos - 1] != '\n')
+        pos--;
+    return pos;
+}
 
-    const auto removals = removalRules.value(functionName);
-    const auto insertions = insertionRules.value(functionName);
+static int LineEnd(QStringView source, int pos)
+{
+    while (pos < source.size() && source[pos] != '\n')
+        pos++;
+    return pos;
+}
 
-    int braceLine = -1;
+static QString LineIndent(QStringView source, int pos)
+{
+    const int start = LineStart(source, pos);
+    int end = start;
+    while (end < source.size() && (source[end] == ' ' || source[end] == '\t'))
+        end++;
+    return source.mid(start, end - start).toString();
+}
+
+static bool IsBlank(QStringView text)
+{
+    return text.trimmed().isEmpty();
+}
 
-    for (int i = 0; i < lines.size(); i++)
+// Statement text without whitespace, to spot code that was already inserted
+static QString Normalized(QStringView text)
+{
+    QString result;
+    result.reserve(text.size());
+    for (const QChar c : text)
     {
-        output << lines[i];
+        if (!c.isSpace())
+            result += c.toLower();
+    }
+    return result;
+}
 
-        if (braceLine == -1 && lines[i].contains('{'))
-        {
-            braceLine = i;
 
-            // insert immediately after opening brace
-            for (const auto& rule : insertions)
-            {
-                if (rule.afterCall.isEmpty())
-                    output << "    " + rule.insertCode;
-            }
+//-----------------------------------------------------
+// Transform function calls, nested calls included
+//-----------------------------------------------------
+static void CollectCallEdits(
+    QStringView source,
+    const std::vector<GSC::Call>& calls,
+    const GSC::RuleSet& rules,
+    QVector<TextEdit>& edits,
+    RuleHits& hits);
+
+static QString RewriteArgument(
+    QStringView source,
+    const GSC::Argument& arg,
+    const GSC::RuleSet& rules,
+    RuleHits& hits)
+{
+    QVector<TextEdit> edits;
+    CollectCallEdits(source, arg.calls, rules, edits, hits);
+    return ApplyEdits(source, arg.range.start, arg.range.end, edits);
+}
+
+static void CollectCallEdits(
+    QStringView source,
+    const std::vector<GSC::Call>& calls,
+    const GSC::RuleSet& rules,
+    QVector<TextEdit>& edits,
+    RuleHits& hits)
+{
+    for (const auto& call : calls)
+    {
+        const auto* mapping = rules.findMapping(call.name);
 
+        const bool mapped = mapping &&
+            (mapping->minArgs == -1 || static_cast<int>(call.args.size()) >= mapping->minArgs);
+
+        if (mapped)
+            hits["map " + mapping->oldName]++;
+
+        if (mapped && !mapping->replacement.isEmpty())
+        {
+            QStringList args;
+            for (const auto& arg : call.args)
+                args << RewriteArgument(source, arg, rules, hits);
+
+            edits.push_back({ call.range.start, call.range.end, mapping->apply(args) });
             continue;
         }
 
-        if (braceLine == -1)
+        if (mapped)
+            edits.push_back({ call.nameRange.start, call.nameRange.end, mapping->newName });
+
+        for (const auto& arg : call.args)
+            CollectCallEdits(source, arg.calls, rules, edits, hits);
+    }
+}
+
+
+//-----------------------------------------------------
+// Removal and insertion rules for a single function
+//-----------------------------------------------------
+static void CollectFunctionEdits(
+    QStringView source,
+    const GSC::Function& function,
+    const GSC::RuleSet& rules,
+    const GSC::RuleContext& context,
+    QVector<TextEdit>& edits,
+    QSet<int>& removedStatements,
+    RuleHits& hits)
+{
+    if (!rules.hasRulesFor(function.name))
+        return;
+
+    const GSC::FunctionTriggers triggers = rules.triggersFor(function.name, context);
+    if (triggers.isEmpty())
+        return;
+
+    // re-converting an edited script must not insert the same code twice
+    QSet<QString> existing;
+    for (const auto& statement : function.statements)
+        existing.insert(Normalized(statement.range.text(source)));
+
+    const auto alreadyThere = [&existing](const QString& code)
+    {
+        return existing.contains(Normalized(code));
+    };
+
+    //-------------------------------------------------
+    // Insert immediately after opening brace
+    //-------------------------------------------------
+    if (!triggers.insertAtBodyStart.isEmpty())
+    {
+        const QString bodyIndent = function.statements.empty()
+            ? LineIndent(source, function.bodyOpen) + "    "
+            : LineIndent(source, function.statements.front().range.start);
+
+        const int bodyLineEnd = LineEnd(source, function.bodyOpen);
+
+        for (const auto& code : triggers.insertAtBodyStart)
+        {
+            if (alreadyThere(code))
+                continue;
+
+            edits.push_back({ bodyLineEnd, bodyLineEnd, "\n" + bodyIndent + code });
+            hits["insert " + code]++;
+        }
+    }
+
+    for (const auto& statement : function.statements)
+    {
+        if (!statement.startsWithCall())
             continue;
 
-        QString trimmed = lines[i].trimmed();
+        const auto* action = triggers.find(statement.calls.front().name);
+        if (!action)
+            continue;
 
         //-------------------------------------------------
         // Remove function calls
         //-------------------------------------------------
-        bool removeLine = false;
-
-        for (const auto& removeFunc : removals)
+        if (action->remove)
         {
-            if (trimmed.startsWith(removeFunc + "("))
+            int start = statement.range.start;
+            int end = statement.range.end;
+
+            // drop the whole line when the statement is the only thing on it
+            const int lineStart = LineStart(source, start);
+            const int lineEnd = LineEnd(source, end);
+            if (IsBlank(source.mid(lineStart, start - lineStart)) && IsBlank(source.mid(end, lineEnd - end)))
             {
-                output.removeLast();
-                removeLine = true;
-                break;
+                start = lineStart;
+                end = std::min(lineEnd + 1, static_cast<int>(source.size()));
             }
-        }
 
-        if (removeLine)
+            edits.push_back({ start, end, {} });
+            removedStatements.insert(statement.range.start);
+            hits["remove " + statement.calls.front().name + " in " + function.name]++;
             continue;
+        }
 
         //-------------------------------------------------
         // Insert after function calls
         //-------------------------------------------------
-        for (const auto& rule : insertions)
+        const int lineEnd = LineEnd(source, statement.range.end);
+        const QString indent = LineIndent(source, statement.range.start);
+
+        for (const auto& code : action->insertAfter)
         {
-            if (!rule.afterCall.isEmpty() &&
-                trimmed.startsWith(rule.afterCall + "("))
-            {
-                output << "    " + rule.insertCode;
-            }
+            if (alreadyThere(code))
+                continue;
+
+            edits.push_back({ lineEnd, lineEnd, "\n" + indent + code });
+            hits["insert " + code]++;
         }
     }
-
-    return output.join('\n');
 }
 
 
 //-----------------------------------------------------
-// Transform function calls globally
+// Conversion manifest, kept next to the converted
+// scripts so re-exports can skip unchanged files
 //-----------------------------------------------------
-static QString TransformFunctionCalls(
-    const QString& input,
-    const MappingMap& mappings)
-{
-    static const QRegularExpression callRegex(
-        R"((self\s+)?([A-Za-z0-9_:\\]+)\s*\(([^)]*)\))"
-    );
+static const QString ManifestFileName = "gsc_manifest.json";
+static const QString OutputCacheFolder = ".gsc_cache";
 
-    QString output;
-    output.reserve(input.size());
-
-    int lastPos = 0;
-
-    auto matches = callRegex.globalMatch(input);
-
-    while (matches.hasNext())
-    {
-        auto match = matches.next();
+struct ManifestEntry
+{
+    QString inputHash;
+    QString outputHash;
+    QString rulesKey;
+};
 
-        output += QStringView(input).mid(lastPos,
-            match.capturedStart() - lastPos);
+using Manifest = QHash<QString, ManifestEntry>;
 
-        const QString selfPrefix = match.captured(1);
-        const QString functionName = match.captured(2);
+static QString HashContent(const QByteArray& data)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+}
 
-        if (!mappings.contains(functionName))
-        {
-            output += match.captured(0);
-            lastPos = match.capturedEnd();
-            continue;
-        }
+// Identifies everything that affects a conversion's output besides the input itself
+static QString RulesKey(const GSC_Convert_Settings& settings, const GSC::RuleSet& rules)
+{
+    return QString("%1@%2:%3%4%5%6%7%8%9")
+        .arg(rules.name())
+        .arg(rules.version())
+        .arg(int(settings.hasDestructibles))
+        .arg(int(settings.hasAnimatedModels))
+        .arg(int(settings.hasPipes))
+        .arg(int(settings.hasMinefields))
+        .arg(int(settings.hasRadiation))
+        .arg(int(settings.isMpMap))
+        .arg(int(settings.minify));
+}
 
-        QStringList args =
-            match.captured(3).split(',', Qt::SkipEmptyParts);
+static Manifest LoadManifest(const QString& path)
+{
+    Manifest manifest;
 
-        for (auto& arg : args)
-            arg = arg.trimmed();
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return manifest;
 
-        const auto& mapping = mappings[functionName];
+    const QJsonObject files = QJsonDocument::fromJson(file.readAll()).object()["files"].toObject();
+    for (auto it = files.begin(); it != files.end(); ++it)
+    {
+        const QJsonObject entry = it.value().toObject();
+        manifest.insert(it.key(), {
+            entry["input"].toString(),
+            entry["output"].toString(),
+            entry["rules"].toString() });
+    }
 
-        if (mapping.minArgs != -1 &&
-            args.size() < mapping.minArgs)
-        {
-            output += match.captured(0);
-            lastPos = match.capturedEnd();
-            continue;
-        }
+    return manifest;
+}
 
-        QString replacement;
+static void SaveManifest(const QString& path, const Manifest& manifest)
+{
+    QJsonObject files;
+    for (auto it = manifest.cbegin(); it != manifest.cend(); ++it)
+    {
+        QJsonObject entry;
+        entry["input"] = it->inputHash;
+        entry["output"] = it->outputHash;
+        entry["rules"] = it->rulesKey;
+        files[it.key()] = entry;
+    }
 
-        if (mapping.transformer)
-        {
-            replacement = mapping.transformer(args);
-        }
-        else
-        {
-            replacement = QString("%1%2(%3)")
-                .arg(selfPrefix)
-                .arg(mapping.newName)
-                .arg(args.join(", "));
-        }
+    QJsonObject root;
+    root["version"] = 1;
+    root["files"] = files;
 
-        output += replacement;
-        lastPos = match.capturedEnd();
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+    {
+        qWarning() << "Failed to write GSC manifest:" << path;
+        return;
     }
 
-    output += QStringView(input).mid(lastPos);
-
-    return output;
+    file.write(QJsonDocument(root).toJson());
+    file.close();
 }
 
 
 //-----------------------------------------------------
-// Main conversion
+// Main conversion, returns the file's log lines so
+// parallel conversions can be reported in order
 //-----------------------------------------------------
-void ConvertGSCFile(
-    const QString& gscPath,
-    const GSC_Convert_Settings& settings)
+struct ConvertResult
 {
-    QFile file(gscPath);
+    QStringList log;
+    QString relativePath;
+    ManifestEntry entry;
+    bool valid = false;
+    RuleHits hits;
+    qint64 bytesSaved = 0;
+};
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+// Maps the script instead of streaming it, dropping the \r of \r\n line endings while copying
+static bool ReadScript(const QString& path, QByteArray& data)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = file.size();
+    const uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+
+    if (!mapped)
     {
-        qDebug() << "Failed reading:" << gscPath;
-        return;
+        data = file.readAll();
+        data.replace("\r\n", "\n");
+        return true;
     }
 
-    QString content = QTextStream(&file).readAll();
-    file.close();
+    data.resize(size);
+    char* out = data.data();
+    qint64 length = 0;
 
-    //-------------------------------------------------
-    // Build mappings
-    //-------------------------------------------------
-    MappingMap mappings =
+    for (qint64 i = 0; i < size; i++)
     {
-        {
-            "wait",
-            {
-                "wait",
-                "wait",
-                1,
-                [](const QStringList& args)
-                {
-                    return args.isEmpty()
-                        ? "wait();"
-                        : QString("wait(%1);").arg(args[0]);
-                }
-            }
-        },
+        if (mapped[i] == '\r' && i + 1 < size && mapped[i + 1] == '\n')
+            continue;
+        out[length++] = static_cast<char>(mapped[i]);
+    }
 
-        {
-            "maps\\mp\\_utility::createOneshotEffect",
-            {
-                "maps\\mp\\_utility::createOneshotEffect",
-                "common_scripts\\utility::createOneshotEffect"
-            }
-        },
+    data.resize(length);
+    file.unmap(const_cast<uchar*>(mapped));
+    return true;
+}
 
-        {
-            "maps\\mp\\_utility::createLoopEffect",
-            {
-                "maps\\mp\\_utility::createLoopEffect",
-                "common_scripts\\utility::createLoopEffect"
-            }
-        }
-    };
+static QByteArray ConvertGSCContent(
+    const QString& gscPath,
+    const QByteArray& input,
+    const GSC_Convert_Settings& settings,
+    const GSC::RuleSet& rules,
+    RuleHits& hits)
+{
+    const GSC::Script script = GSC::parse(QString::fromUtf8(input));
+    const QStringView content = script.source;
 
     //-------------------------------------------------
-    // Removal rules
+    // Per-file context for rule conditions
     //-------------------------------------------------
-    RemovalMap removals =
+    GSC::RuleContext context;
+
+    if (settings.hasDestructibles) context.flags << "hasDestructibles";
+    if (settings.hasAnimatedModels) context.flags << "hasAnimatedModels";
+    if (settings.hasPipes) context.flags << "hasPipes";
+    if (settings.hasMinefields) context.flags << "hasMinefields";
+    if (settings.hasRadiation) context.flags << "hasRadiation";
+    if (settings.isMpMap) context.flags << "isMpMap";
+
+    context.variables["map"] = QFileInfo(gscPath).baseName();
+    context.variables["load"] = settings.isMpMap
+        ? "maps\\mp\\_load::main"
+        : "maps\\_load::main";
+
+    QSet<QString> calledNames;
+    script.forEachCall([&](const GSC::Call& call)
     {
-        { "main", { "setExpFog" } }
+        calledNames.insert(call.name.toLower());
+    });
+
+    context.calls = [&calledNames](const QString& name)
+    {
+        if (!name.startsWith('*'))
+            return calledNames.contains(name.toLower());
+
+        const QString suffix = name.mid(1);
+        return std::any_of(calledNames.cbegin(), calledNames.cend(), [&](const QString& called)
+        {
+            return called.endsWith(suffix, Qt::CaseInsensitive);
+        });
     };
 
     //-------------------------------------------------
-    // Insertion rules
+    // Collect edits from the parsed functions
     //-------------------------------------------------
-    InsertionMap insertions;
-
-    const QString loadName = settings.isMpMap
-        ? "maps\\mp\\_load::main"
-        : "maps\\_load::main";
+    QVector<TextEdit> edits;
+    QSet<int> removedStatements;
 
-    if (content.contains(loadName))
+    for (const auto& function : script.functions)
     {
-        auto& mainRules = insertions["main"];
+        CollectFunctionEdits(content, function, rules, context, edits, removedStatements, hits);
+    }
 
-        if (!content.contains("_art::main()"))
+    for (const auto& function : script.functions)
+    {
+        for (const auto& statement : function.statements)
         {
-            mainRules.push_back({
-                "",
-                QString("maps\\createart\\%1_art::main();")
-                    .arg(QFileInfo(gscPath).baseName())
-                });
+            if (!removedStatements.contains(statement.range.start))
+                CollectCallEdits(content, statement.calls, rules, edits, hits);
         }
-
-        if (settings.hasDestructibles)
-            mainRules.push_back({
-                loadName,
-                "thread common_scripts\\_destructible::init();"
-                });
-
-        if (settings.hasPipes)
-            mainRules.push_back({
-                loadName,
-                "thread common_scripts\\_pipes::init();"
-                });
-
-        if (settings.hasAnimatedModels)
-            mainRules.push_back({
-                loadName,
-                settings.isMpMap
-                    ? "thread maps\\mp\\_animatedmodels::main();"
-                    : "thread maps\\_animatedmodels::main();"
-                });
     }
 
-    //-------------------------------------------------
-    // Parse functions
-    //-------------------------------------------------
-    static const QRegularExpression functionRegex(
-        R"(^\s*(\w+)\s*\([^)]*\)\s*\n?\s*\{)",
-        QRegularExpression::MultilineOption
-    );
+    return ApplyEditsUtf8(input, content, std::move(edits));
+}
 
-    QString output;
-    output.reserve(content.size());
+// Objects are named by their content, so one that exists is already right. Parallel
+// workers can produce the same object, it's written under a temporary name and renamed
+// so nobody ever sees half of one.
+static void StoreCacheObject(const QString& cachePath, const QString& hash, const QByteArray& content)
+{
+    const QString objectPath = cachePath + hash;
+    if (QFile::exists(objectPath))
+        return;
 
-    int offset = 0;
-    int searchPos = 0;
+    QDir().mkpath(cachePath);
 
-    while (true)
-    {
-        auto match = functionRegex.match(content, searchPos);
+    // written like the script itself, so a restore gives back the same bytes
+    QSaveFile file(objectPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return;
 
-        if (!match.hasMatch())
-            break;
+    file.write(content);
+    file.commit();
+}
 
-        const QString functionName = match.captured(1);
-        const int start = match.capturedStart();
-        const int bodyStart = match.capturedEnd();
+static ConvertResult ConvertGSCFile(
+    const QString& gscPath,
+    const QString& destinationPath,
+    const GSC_Convert_Settings& settings,
+    const GSC::RuleSet& rules,
+    const QString& rulesKey,
+    const Manifest& manifest)
+{
+    ConvertResult result{};
+    result.relativePath = QDir(destinationPath).relativeFilePath(gscPath);
 
-        output += QStringView(content).mid(offset, start - offset);
+    QByteArray input;
 
-        int end = FindFunctionEnd(content, bodyStart);
+    if (!ReadScript(gscPath, input))
+    {
+        result.log << "Failed reading: " + gscPath;
+        return result;
+    }
 
-        QStringView functionBlock(content.data() + start, end - start);
+    const QString inputHash = HashContent(input);
+    const auto previous = manifest.constFind(result.relativePath);
+    const bool sameRules = previous != manifest.constEnd() && previous->rulesKey == rulesKey;
 
-        output += ProcessFunctionBlock(
-            functionName,
-            functionBlock,
-            removals,
-            insertions
-        );
+    const QString cachePath = destinationPath + "/" + OutputCacheFolder + "/";
 
-        offset = end;
-        searchPos = end;
+    //-------------------------------------------------
+    // Dry runs of converted scripts start from the
+    // original their conversion kept in the cache
+    //-------------------------------------------------
+    if (settings.dryRun && previous != manifest.constEnd() && inputHash == previous->outputHash)
+    {
+        if (!ReadScript(cachePath + previous->inputHash, input))
+        {
+            result.log << "Already converted and the original isn't cached, dump again to dry run: " + gscPath;
+            return result;
+        }
     }
 
-    output += QStringView(content).mid(offset);
+    //-------------------------------------------------
+    // Already converted, converting again would
+    // repeat insertions
+    //-------------------------------------------------
+    else if (previous != manifest.constEnd() && inputHash == previous->outputHash)
+    {
+        result.entry = *previous;
+        result.valid = true;
+        result.log << (sameRules
+            ? "Up to date: " + gscPath
+            : "Already converted with older rules, dump again to apply the new ones: " + gscPath);
+        return result;
+    }
+
+    //-------------------------------------------------
+    // Same input as last time, restore the cached output
+    //-------------------------------------------------
+    if (!settings.dryRun && sameRules && inputHash == previous->inputHash &&
+        QFile::exists(cachePath + previous->outputHash))
+    {
+        if (QtUtils::copyFile(cachePath + previous->outputHash, gscPath))
+        {
+            result.entry = *previous;
+            result.valid = true;
+            result.log << "Restored: " + gscPath;
+            return result;
+        }
+    }
+
+    const QByteArray converted = ConvertGSCContent(gscPath, input, settings, rules, result.hits);
+    QByteArray output = converted;
 
     //-------------------------------------------------
-    // Final transform pass
+    // Minify
     //-------------------------------------------------
-    output = TransformFunctionCalls(output, mappings);
+    if (settings.minify)
+    {
+        output = GSC::minify(QString::fromUtf8(converted)).toUtf8();
+        result.bytesSaved = converted.size() - output.size();
+        result.log << QString("Minified: %1 (%2 -> %3 bytes, %4 saved)")
+            .arg(result.relativePath)
+            .arg(converted.size())
+            .arg(output.size())
+            .arg(result.bytesSaved);
+    }
+
+    //-------------------------------------------------
+    // Dry run, report what would change
+    //-------------------------------------------------
+    if (settings.dryRun)
+    {
+        // minified output would be one big hunk, diff the plain conversion
+        const QString diff = Diff::unified(result.relativePath,
+            QString::fromUtf8(input), QString::fromUtf8(converted));
+
+        if (!diff.isEmpty())
+            result.log << diff;
+        return result;
+    }
 
     //-------------------------------------------------
     // Write result
     //-------------------------------------------------
+    QFile file(gscPath);
+
     if (!file.open(
         QIODevice::WriteOnly |
         QIODevice::Text |
         QIODevice::Truncate))
     {
-        qDebug() << "Failed writing:" << gscPath;
-        return;
+        result.log << "Failed writing: " + gscPath;
+        return result;
     }
 
-    QTextStream(&file) << output;
+    file.write(output);
     file.close();
 
-    qDebug() << "Converted:" << gscPath;
+    result.entry = { inputHash, HashContent(output), rulesKey };
+    result.valid = true;
+
+    StoreCacheObject(cachePath, result.entry.outputHash, output);
+
+    // keeps the script as dumped around for dry runs of later rule changes
+    StoreCacheObject(cachePath, inputHash, input);
+
+    result.log << "Converted: " + gscPath;
+    return result;
 }
 
 QStringList findAllGSCFiles(const QString& root)
@@ -376,18 +682,119 @@ QStringList findAllGSCFiles(const QString& root)
 	return result;
 }
 
-void ConvertGSCFiles(const QString& destinationPath, GSC_Convert_Settings settings)
+void ConvertGSCFiles(
+	const QString& destinationPath,
+	GSC_Convert_Settings settings,
+	QObject* context,
+	std::function<void(bool)> onFinished,
+	const QStringList& files)
 {
 	// For each gsc file in destinationPath, convert the GSC file.
 	QDir dir(destinationPath);
 	if (!dir.exists()) {
 		qDebug() << "Directory does not exist:" << destinationPath;
+		onFinished(false);
 		return;
 	}
-	QStringList gscFiles = findAllGSCFiles(destinationPath);
-	for (const QString& path : gscFiles) {
-		qDebug() << "[ConvertGSCFiles] Converting GSC file:" << path;
-		ConvertGSCFile(path, settings);
+
+	// Loaded once and shared read-only by every worker
+	const std::shared_ptr<const GSC::RuleSet> rules = GSC::RuleSet::load(settings.sourceGameType);
+	if (!rules) {
+		qCritical() << "[ConvertGSCFiles] No GSC rules, leaving the scripts in" << destinationPath << "unconverted";
+		onFinished(false);
+		return;
 	}
-	qDebug() << "All GSC files converted in:" << destinationPath;
-}
\ No newline at end of file
+
+	const QStringList gscFiles = files.isEmpty() ? findAllGSCFiles(destinationPath) : files;
+	qDebug() << (settings.dryRun ? "[ConvertGSCFiles] Dry run over" : "[ConvertGSCFiles] Converting")
+		<< gscFiles.size() << "GSC files on" << QThreadPool::globalInstance()->maxThreadCount() << "threads";
+
+	// Dry runs always convert, they only use the manifest to find the originals of converted scripts
+	const QString manifestPath = destinationPath + "/" + ManifestFileName;
+	const auto previousManifest = std::make_shared<const Manifest>(LoadManifest(manifestPath));
+	const QString rulesKey = RulesKey(settings, *rules);
+
+	// Files are independent, spread them over the global thread pool
+	QFuture<ConvertResult> future = QtConcurrent::mapped(gscFiles,
+		[destinationPath, settings, rules, rulesKey, previousManifest](const QString& path) {
+		return ConvertGSCFile(path, destinationPath, settings, *rules, rulesKey, *previousManifest);
+	});
+
+	// What the finished files add up to, gathered on the ui thread
+	struct Totals
+	{
+		Manifest manifest;
+		RuleHits hits;
+		qint64 bytesSaved = 0;
+		int nextLog = 0;
+	};
+
+	const auto totals = std::make_shared<Totals>();
+	if (!files.isEmpty())
+		totals->manifest = *previousManifest;
+
+	// Print each file's log in file order as soon as it and all files before it are done
+	const auto flushLogs = [totals, future, count = gscFiles.size()]() {
+		while (totals->nextLog < count && future.isResultReadyAt(totals->nextLog)) {
+			const ConvertResult result = future.resultAt(totals->nextLog);
+			for (const QString& line : result.log)
+				qDebug().noquote() << line;
+			if (result.valid)
+				totals->manifest.insert(result.relativePath, result.entry);
+			for (auto it = result.hits.cbegin(); it != result.hits.cend(); ++it)
+				totals->hits[it.key()] += it.value();
+			totals->bytesSaved += result.bytesSaved;
+			totals->nextLog++;
+		}
+	};
+
+	const auto finish = [=]() {
+		flushLogs();
+
+		if (settings.minify)
+			qDebug() << "[ConvertGSCFiles] Minifying saved" << totals->bytesSaved << "bytes";
+
+		if (settings.dryRun) {
+			// Most used rules first
+			QList<QPair<QString, int>> sortedHits;
+			for (auto it = totals->hits.cbegin(); it != totals->hits.cend(); ++it)
+				sortedHits.append({ it.key(), it.value() });
+			std::sort(sortedHits.begin(), sortedHits.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+
+			qDebug() << "[ConvertGSCFiles] Rule hits:";
+			for (const auto& hit : sortedHits)
+				qDebug().noquote() << QString("%1 x %2").arg(hit.second, 6).arg(hit.first);
+
+			qDebug() << "Dry run finished, nothing was written in:" << destinationPath;
+			onFinished(true);
+			return;
+		}
+
+		SaveManifest(manifestPath, totals->manifest);
+
+		// Drop cached outputs nothing refers to anymore
+		QSet<QString> referenced;
+		for (const auto& entry : totals->manifest) {
+			referenced.insert(entry.inputHash);
+			referenced.insert(entry.outputHash);
+		}
+
+		QDir cacheDir(destinationPath + "/" + OutputCacheFolder);
+		for (const QString& cached : cacheDir.entryList(QDir::Files)) {
+			if (!referenced.contains(cached))
+				cacheDir.remove(cached);
+		}
+
+		qDebug() << "All GSC files converted in:" << destinationPath;
+		onFinished(true);
+	};
+
+	// The workers report back through the event loop, callers go on with whatever else is running meanwhile
+	auto* watcher = new QFutureWatcher<ConvertResult>(context);
+	QObject::connect(watcher, &QFutureWatcherBase::resultReadyAt, watcher, flushLogs);
+	QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [watcher, finish]() {
+		watcher->deleteLater();
+		finish();
+	});
+	watcher->setFuture(future);
+}
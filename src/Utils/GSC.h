@@ -2,6 +2,8 @@
 
 #include <QtWidgets/QtWidgets>
 
+#include "../Shared.h"
+
 struct GSC_Convert_Settings
 {
 	bool hasDestructibles = false;
@@ -11,8 +13,23 @@ struct GSC_Convert_Settings
 	bool hasRadiation = false;
 
 	bool isMpMap = false;
+
+	GameType sourceGameType = IW3; // selects static/gsc_rules/<game>.json
+
+	bool dryRun = false; // log diffs and rule hit counts instead of writing
+
+	bool minify = false; // strip comments and whitespace from the converted output
 };
 
 QStringList findAllGSCFiles(const QString& root);
 
-void ConvertGSCFiles(const QString& destinationPath, GSC_Convert_Settings settings);
\ No newline at end of file
+// Converts every script under destinationPath, or only the given files, keeping the manifest entries of the rest.
+// Files convert on the global thread pool, their logs come out in file order on the ui thread and onFinished
+// runs there once all of them are done. It gets false when nothing could be converted, like when the rules
+// for the source game don't load. Nothing is reported once context is gone.
+void ConvertGSCFiles(
+	const QString& destinationPath,
+	GSC_Convert_Settings settings,
+	QObject* context,
+	std::function<void(bool)> onFinished,
+	const QStringList& files = {});
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "GSCBuiltins.h"
+
+#include <algorithm>
+#include <string_view>
+
+namespace GSC
+{
+    namespace
+    {
+        // Kept sorted and lowercase, lookups are a binary search
+        constexpr std::string_view builtinFunctions[] =
+        {
+            "abs", "acos", "allclientsprint", "ambientplay", "ambientstop", "angleclamp", "angleclamp180",
+            "anglesdelta", "anglestoforward", "anglestoright", "anglestoup", "announcement", "asin", "assert",
+            "assertex", "assertmsg", "atan", "axistoangles", "badplace_brush", "badplace_cylinder",
+            "badplace_delete", "breakpoint", "bullettrace", "bullettracepassed", "ceil", "changelevel", "clamp",
+            "closer", "combineangles", "cos", "createthreatbiasgroup", "distance", "distance2d", "distance2dsquared",
+            "distancesquared", "earthquake", "exitlevel", "float", "floor", "getaiarray", "getaispeciesarray",
+            "getallnodes", "getarraykeys", "getclosestnodeinsight", "getcorpsearray", "getdvar", "getdvarfloat",
+            "getdvarint", "getdvarvector", "getent", "getentarray", "getentbynum", "getfirstarraykey",
+            "getmapsundirection", "getmapsunlight", "getnextarraykey", "getnode", "getnodearray", "getnodesinradius",
+            "getnodesinradiussorted", "getnumparts", "getomnvar", "getpartname", "getstartangles", "getstartorigin",
+            "getsubstr", "getteamscore", "gettime", "getvehiclenode", "getvehiclenodearray", "getweaponmodel", "int",
+            "iprintln", "iprintlnbold", "isai", "isalive", "isarray", "isdefined", "isendstr", "isplayer",
+            "issaverecentlyloaded", "issentient", "isspawner", "isstring", "issubstr", "killfxontag", "length",
+            "lengthsquared", "line", "loadfx", "logprint", "lookupsoundlength", "magicbullet", "magicgrenade",
+            "magicgrenademanual", "map_restart", "max", "min", "missionfailed", "missionsuccess", "musicplay",
+            "musicstop", "newclienthudelem", "newhudelem", "newteamhudelem", "objective_add",
+            "objective_additionalposition", "objective_current", "objective_delete", "objective_icon",
+            "objective_onentity", "objective_position", "objective_state", "objective_string", "objective_team",
+            "physicsexplosioncylinder", "physicsexplosionsphere", "physicsjolt", "physicstrace",
+            "playerphysicstrace", "playfx", "playfxontag", "playfxontagforclients", "playloopedfx",
+            "playrumblelooponposition", "playrumbleonposition", "playsoundatpos", "pointonsegmentnearesttopoint",
+            "precachecompassicon", "precachefxontag", "precacheitem", "precacheleaderboards", "precachemenu",
+            "precachemodel", "precachempanim", "precachenightvisioncodeassets", "precacherumble", "precacheshader",
+            "precacheshellshock", "precachesound", "precachestring", "precachetag", "precacheturret",
+            "precachevehicle", "print", "print3d", "println", "prof_begin", "prof_end", "radiusdamage",
+            "randomfloat", "randomfloatrange", "randomint", "randomintrange", "resetsunlight", "resettimeout",
+            "savegame", "setblur", "setclientnamemode", "setculldist", "setdevdvarifuninitialized", "setdvar",
+            "setdvarifuninitialized", "setexpfog", "setgameendtime", "setignoremegroup", "setmapcenter",
+            "setnorthyaw", "setomnvar", "setsaveddvar", "setslowmotion", "setsunflareposition", "setsunlight",
+            "setteamscore", "setthreatbias", "setwinningteam", "sighttracepassed", "sin", "spawn", "spawnfx",
+            "spawnstruct", "spawnturret", "spawnvehicle", "sqrt", "squared", "stopfxontag", "strtok", "tablelookup",
+            "tablelookupistring", "tan", "threatbiasgroupexists", "tolower", "toupper", "triggerfx", "vectorcross",
+            "vectordot", "vectorfromlinetopoint", "vectorlerp", "vectornormalize", "vectortoangles", "vectortoyaw",
+            "visionsetmissilecam", "visionsetnaked", "visionsetnight", "visionsetpain", "visionsetthermal", "wait",
+            "waittillframeend", "weaponclass", "weaponclipsize", "weaponfiretime", "weaponinventorytype",
+            "weaponmaxammo", "weaponstartammo", "weapontype", "worldentnumber"
+        };
+
+        constexpr std::string_view builtinMethods[] =
+        {
+            "adsbuttonpressed", "allowads", "allowcrouch", "allowjump", "allowprone", "allowsprint", "allowstand",
+            "animcustom", "animscripted", "attach", "attachpath", "attackbuttonpressed", "changefontscaleovertime",
+            "clearanim", "clearentitytarget", "cleargoalyaw", "clearlookatentity", "clearperks", "cleartargetent",
+            "closemenu", "closepopupmenu", "connectpaths", "damageconetrace", "delete", "destroy", "detach",
+            "detachall", "disableoffhandweapons", "disableweapons", "disableweaponswitch", "disconnectpaths",
+            "dodamage", "enablegrenadetouchdamage", "enablelinkto", "enableoffhandweapons", "enableweapons",
+            "enableweaponswitch", "endon", "fadeovertime", "fireweapon", "fragbuttonpressed", "freezecontrols",
+            "getanimtime", "getcentroid", "getcurrentweapon", "getentitynumber", "getlightcolor",
+            "getlightintensity", "getorigin", "getplayerangles", "getpointinbounds", "getstance", "gettagangles",
+            "gettagorigin", "getthreatbiasgroup", "getturretowner", "getvelocity", "getweaponammoclip",
+            "getweaponammostock", "getweaponslist", "getweaponslistprimaries", "givemaxammo", "giveweapon",
+            "hasperk", "hasweapon", "hide", "hidefromplayer", "hidepart", "isfiring", "islinked", "isonground",
+            "isreloading", "istouching", "kill", "laseroff", "laseron", "linkto", "maketurretinoperable",
+            "maketurretoperable", "makeunusable", "makeusable", "meleebuttonpressed", "movegravity", "moveovertime",
+            "moveto", "movex", "movey", "movez", "neargoalnotifydist", "notify", "notifyonplayercommand",
+            "notsolid", "openpopupmenu", "physicslaunchclient", "playerlinkto", "playerlinktoabsolute",
+            "playerlinktodelta", "playlocalsound", "playloopsound", "playrumbleonentity", "playsound",
+            "playsoundasmaster", "playsoundtoplayer", "playsoundtoteam", "pushplayer", "rotatepitch", "rotateroll",
+            "rotateto", "rotatevelocity", "rotateyaw", "scaleovertime", "scalepitch", "scalevolume",
+            "scriptmodelclearanim", "scriptmodelplayanim", "setacceleration", "setactionslot", "setairresistance",
+            "setanim", "setanimknob", "setanimknoball", "setanimknoballrestart", "setanimknoblimited",
+            "setanimlimited", "setanimrestart", "setanimtime", "setblurforplayer", "setbottomarc", "setcandamage",
+            "setcanradiusdamage", "setclientdvar", "setclientdvars", "setclientomnvar", "setclock", "setcontents",
+            "setconvergencetime", "setcursorhint", "setdeceleration", "setdefaultdroppitch", "setdepthoffield",
+            "setempjammed", "setengagementmaxdist", "setengagementmindist", "setentitytarget", "setflaggedanim",
+            "setflaggedanimknob", "setflaggedanimknoball", "setflaggedanimlimited", "setflaggedanimrestart",
+            "setgametypestring", "setgoalentity", "setgoalnode", "setgoalpos", "setgoalvolume", "setgoalvolumeauto",
+            "setgoalyaw", "sethintstring", "sethoverparams", "setjitterparams", "setleftarc", "setlightcolor",
+            "setlightfovrange", "setlightintensity", "setlightradius", "setlookatentity", "setmapnamestring",
+            "setmaxpitchroll", "setmode", "setmodel", "setmovespeedscale", "setnormalhealth", "setorigin",
+            "setperk", "setplayerangles", "setplayernamestring", "setpulsefx", "setrank", "setrightarc",
+            "setscriptablepartstate", "setshader", "setshadowhint", "setsoundblend", "setspawnweapon", "setspeed",
+            "setstance", "settargetent", "settargetyaw", "settenthstimer", "settext", "setthreatbiasgroup",
+            "settimer", "settimerup", "settoparc", "setturningability", "setturretignoregoals",
+            "setturrettargetent", "setturrettargetvec", "setturretteam", "setvalue", "setvehgoalpos", "setvelocity",
+            "setweaponammoclip", "setweaponammostock", "setyawspeed", "shellshock", "show", "showpart",
+            "showtoplayer", "sightconetrace", "solid", "sprintbuttonpressed", "startfiring", "startpath",
+            "startusingheroonlylighting", "stopanimscripted", "stopfiring", "stoplocalsound", "stoploopsound",
+            "stoprumble", "stopshellshock", "stopsounds", "stopusingheroonlylighting", "suicide", "switchtoweapon",
+            "takeallweapons", "takeweapon", "teleport", "unlink", "unsetperk", "useanimtree", "usebuttonpressed",
+            "useby", "usetriggerrequirelookat", "vehicle_setspeed", "vehicle_setspeedimmediate", "vehicle_teleport",
+            "vehicle_turnengineoff", "vehicle_turnengineon", "viewkick", "visionsetnakedforplayer", "waittill",
+            "waittillmatch", "willneverchange"
+        };
+
+        static_assert(std::ranges::is_sorted(builtinFunctions), "builtinFunctions must stay sorted");
+        static_assert(std::ranges::is_sorted(builtinMethods), "builtinMethods must stay sorted");
+
+        template <std::size_t N>
+        bool contains(const std::string_view (&table)[N], QStringView name)
+        {
+            // identifiers are ascii, anything longer than this isn't in the tables anyway
+            char buffer[64];
+            if (name.size() >= qsizetype(sizeof(buffer)))
+                return false;
+
+            for (qsizetype i = 0; i < name.size(); i++)
+            {
+                const char16_t c = name[i].unicode();
+                if (c > 0x7f)
+                    return false;
+                buffer[i] = static_cast<char>((c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c);
+            }
+
+            return std::ranges::binary_search(table, std::string_view(buffer, name.size()));
+        }
+    }
+
+    bool isBuiltinFunction(QStringView name)
+    {
+        return contains(builtinFunctions, name);
+    }
+
+    bool isBuiltinMethod(QStringView name)
+    {
+        return contains(builtinMethods, name);
+    }
+
+    bool isBuiltin(QStringView name)
+    {
+        return isBuiltinFunction(name) || isBuiltinMethod(name);
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+namespace GSC
+{
+	// Engine functions and entity methods H1 scripts can call, case-insensitive
+	bool isBuiltinFunction(QStringView name);
+	bool isBuiltinMethod(QStringView name);
+
+	// The parser doesn't tell "func()" and "ent func()" apart, calls are checked against both
+	bool isBuiltin(QStringView name);
+}
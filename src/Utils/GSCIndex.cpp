@@ -0,0 +1,134 @@
+#include "GSCIndex.h"
+#include "GSCParser.h"
+#include "QTUtils.h"
+
+#include <QtConcurrent/QtConcurrent>
+
+namespace GSC
+{
+    QString scriptPathFromReference(QStringView reference)
+    {
+        QString path = reference.toString().toLower();
+        path.replace('\\', '/');
+        return path + ".gsc";
+    }
+
+    QString normalizeScriptPath(const QString& path)
+    {
+        QString result = path.trimmed().toLower();
+        result.replace('\\', '/');
+        return result;
+    }
+
+    namespace
+    {
+        ScriptSymbols indexScript(const QString& root, const QString& filePath)
+        {
+            ScriptSymbols symbols{};
+            symbols.path = normalizeScriptPath(QDir(root).relativeFilePath(filePath));
+
+            const Script script = parse(QtUtils::readFile(filePath));
+            const QStringView source = script.source;
+
+            for (const auto& function : script.functions)
+                symbols.functions.insert(function.name.toLower());
+
+            for (const auto& directive : script.directives)
+            {
+                if (directive.value.isEmpty())
+                    continue;
+
+                if (directive.name.compare("include", Qt::CaseInsensitive) == 0)
+                    symbols.includes.insert(scriptPathFromReference(directive.value));
+                else if (directive.name.compare("using_animtree", Qt::CaseInsensitive) == 0)
+                    symbols.animtrees.insert("animtrees/" + directive.value.toLower() + ".atr");
+            }
+
+            script.forEachCall([&symbols](const Call& call)
+            {
+                symbols.calls.push_back({ call.name.toLower(), call.line });
+            });
+
+            // path::func, whether called or taken as a function pointer
+            const auto& tokens = script.tokens;
+            for (qsizetype i = 0; i + 1 < tokens.size(); i++)
+            {
+                if (tokens[i].type != TokenType::Identifier)
+                    continue;
+
+                const Token& next = tokens[i + 1];
+                if (next.type == TokenType::Punctuation && next.text(source) == u"::")
+                    symbols.references.insert(scriptPathFromReference(tokens[i].text(source)));
+            }
+
+            return symbols;
+        }
+    }
+
+    SymbolIndex SymbolIndex::build(const QString& root)
+    {
+        QStringList files;
+        QDirIterator it(root, QStringList() << "*.gsc", QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+            files << it.next();
+
+        const QList<ScriptSymbols> symbols = QtConcurrent::blockingMapped(files, [root](const QString& file)
+        {
+            return indexScript(root, file);
+        });
+
+        SymbolIndex index;
+        index.m_scripts.reserve(symbols.size());
+        for (const auto& script : symbols)
+            index.m_scripts.insert(script.path, script);
+
+        return index;
+    }
+
+    const ScriptSymbols* SymbolIndex::find(const QString& path) const
+    {
+        const auto it = m_scripts.constFind(normalizeScriptPath(path));
+        return it != m_scripts.constEnd() ? &it.value() : nullptr;
+    }
+
+    QSet<QString> SymbolIndex::reachableFrom(const QStringList& roots) const
+    {
+        QSet<QString> reached;
+        QStringList pending;
+
+        for (const auto& root : roots)
+        {
+            const QString path = normalizeScriptPath(root);
+            if (!reached.contains(path))
+            {
+                reached.insert(path);
+                pending << path;
+            }
+        }
+
+        const auto visit = [&](const QString& path)
+        {
+            if (!reached.contains(path))
+            {
+                reached.insert(path);
+                pending << path;
+            }
+        };
+
+        while (!pending.isEmpty())
+        {
+            const auto* script = find(pending.takeLast());
+            if (!script)
+                continue; // lives in another zone, or is an animtree
+
+            for (const auto& path : script->includes)
+                visit(path);
+            for (const auto& path : script->references)
+                visit(path);
+            for (const auto& path : script->animtrees)
+                visit(path);
+        }
+
+        return reached;
+    }
+}
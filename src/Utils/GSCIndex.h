@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+// Cross-file symbol index over the GSC scripts of a zone folder
+namespace GSC
+{
+	// maps\mp\_load -> maps/mp/_load.gsc, lowercase
+	QString scriptPathFromReference(QStringView reference);
+
+	// normalizes a rawfile name or relative path to the index's key format
+	QString normalizeScriptPath(const QString& path);
+
+	struct CallSite
+	{
+		QString name; // lowercase, path::func for calls into other scripts
+		int line = 0;
+	};
+
+	struct ScriptSymbols
+	{
+		QString path;               // relative to the index root, normalized
+		QSet<QString> functions;    // lowercase function definitions
+		QSet<QString> includes;     // #include targets as script paths
+		QSet<QString> references;   // path::func calls and function pointers, as script paths
+		QSet<QString> animtrees;    // #using_animtree targets as animtrees/<name>.atr
+		QVector<CallSite> calls;    // every call site, nested calls included
+	};
+
+	class SymbolIndex
+	{
+	public:
+		// Parses every .gsc under root, spread over the thread pool
+		static SymbolIndex build(const QString& root);
+
+		const ScriptSymbols* find(const QString& path) const;
+		const QHash<QString, ScriptSymbols>& scripts() const { return m_scripts; }
+
+		// Scripts and animtrees reachable from roots through includes, references and #using_animtree
+		QSet<QString> reachableFrom(const QStringList& roots) const;
+
+	private:
+		QHash<QString, ScriptSymbols> m_scripts;
+	};
+}
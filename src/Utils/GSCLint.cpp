@@ -0,0 +1,99 @@
+#include "GSCLint.h"
+#include "GSCBuiltins.h"
+
+#include <QtConcurrent/QtConcurrent>
+
+namespace GSC
+{
+    namespace
+    {
+        struct ScriptLint
+        {
+            int checkedCalls = 0;
+            int externalCalls = 0;
+            QVector<LintIssue> unresolved;
+        };
+
+        ScriptLint lintScript(const SymbolIndex& index, const ScriptSymbols& script)
+        {
+            ScriptLint result{};
+
+            // includes we can see into, and whether any could define things we can't see
+            QVector<const ScriptSymbols*> includes;
+            bool hasExternalIncludes = false;
+            for (const auto& path : script.includes)
+            {
+                if (const auto* include = index.find(path))
+                    includes.push_back(include);
+                else
+                    hasExternalIncludes = true;
+            }
+
+            for (const auto& call : script.calls)
+            {
+                result.checkedCalls++;
+
+                const qsizetype separator = call.name.indexOf("::");
+                if (separator >= 0)
+                {
+                    // path::func, the target script decides
+                    const auto* target = index.find(scriptPathFromReference(QStringView(call.name).left(separator)));
+                    if (!target)
+                        result.externalCalls++;
+                    else if (!target->functions.contains(call.name.mid(separator + 2)))
+                        result.unresolved.push_back({ script.path, call.line, call.name });
+                    continue;
+                }
+
+                if (isBuiltin(call.name) || script.functions.contains(call.name))
+                    continue;
+
+                const bool included = std::any_of(includes.cbegin(), includes.cend(), [&](const ScriptSymbols* include)
+                {
+                    return include->functions.contains(call.name);
+                });
+                if (included)
+                    continue;
+
+                if (hasExternalIncludes)
+                    result.externalCalls++;
+                else
+                    result.unresolved.push_back({ script.path, call.line, call.name });
+            }
+
+            return result;
+        }
+    }
+
+    LintReport lint(const SymbolIndex& index)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        QVector<const ScriptSymbols*> scripts;
+        scripts.reserve(index.scripts().size());
+        for (const auto& script : index.scripts())
+            scripts.push_back(&script);
+
+        const QList<ScriptLint> results = QtConcurrent::blockingMapped(scripts, [&index](const ScriptSymbols* script)
+        {
+            return lintScript(index, *script);
+        });
+
+        LintReport report{};
+        for (const auto& result : results)
+        {
+            report.checkedCalls += result.checkedCalls;
+            report.externalCalls += result.externalCalls;
+            report.unresolved += result.unresolved;
+        }
+
+        std::sort(report.unresolved.begin(), report.unresolved.end(), [](const LintIssue& a, const LintIssue& b)
+        {
+            return a.path != b.path ? a.path < b.path : a.line < b.line;
+        });
+
+        report.elapsedMs = timer.elapsed();
+        return report;
+    }
+}
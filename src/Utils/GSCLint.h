@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+#include "GSCIndex.h"
+
+namespace GSC
+{
+	struct LintIssue
+	{
+		QString path;
+		int line = 0;
+		QString call;
+	};
+
+	struct LintReport
+	{
+		int checkedCalls = 0;
+		int externalCalls = 0;       // may resolve in scripts that live in another zone
+		QVector<LintIssue> unresolved; // sorted by path, then line
+		qint64 elapsedMs = 0;
+
+		bool ok() const { return unresolved.isEmpty(); }
+	};
+
+	// Checks every call site against the H1 builtins, the script's own functions and
+	// whatever its #includes define. Calls that could still come from an include or
+	// a path::func script missing from the index are counted as external, not reported.
+	LintReport lint(const SymbolIndex& index);
+}
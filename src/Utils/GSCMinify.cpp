@@ -0,0 +1,84 @@
+#include "GSCMinify.h"
+#include "GSCParser.h"
+
+namespace GSC
+{
+    namespace
+    {
+        bool isWord(const Token& token)
+        {
+            return token.type == TokenType::Identifier || token.type == TokenType::Number;
+        }
+
+        // a, b were apart in the source, would writing them back to back merge them?
+        bool needsSeparator(QStringView source, const Token& a, const Token& b)
+        {
+            if (isWord(a) && isWord(b))
+                return true;
+
+            const QString joined = a.text(source).toString() + b.text(source);
+            return tokenize(joined).size() != 2;
+        }
+
+        bool sameTokens(QStringView a, const QVector<Token>& aTokens, QStringView b)
+        {
+            const QVector<Token> bTokens = tokenize(b);
+
+            qsizetype j = 0;
+            for (const auto& token : aTokens)
+            {
+                if (token.type == TokenType::Comment)
+                    continue;
+
+                if (j >= bTokens.size() || bTokens[j].type != token.type ||
+                    bTokens[j].text(b) != token.text(a))
+                    return false;
+                j++;
+            }
+
+            return j == bTokens.size();
+        }
+    }
+
+    QString minify(const QString& source)
+    {
+        const Script script = parse(source);
+        const QStringView text = script.source;
+
+        // offsets after which a line break has to stay
+        QSet<int> lineBreaks;
+        for (const auto& directive : script.directives)
+            lineBreaks.insert(directive.range.end);
+        for (const auto& function : script.functions)
+            lineBreaks.insert(function.bodyClose + 1);
+
+        QString output;
+        output.reserve(source.size());
+
+        const Token* previous = nullptr;
+        for (const auto& token : script.tokens)
+        {
+            if (token.type == TokenType::Comment)
+                continue;
+
+            if (previous && !output.endsWith('\n') && previous->end() != token.start &&
+                needsSeparator(text, *previous, token))
+                output += ' ';
+
+            output += token.text(text);
+
+            if (lineBreaks.contains(token.end()))
+                output += '\n';
+
+            previous = &token;
+        }
+
+        if (!output.isEmpty() && !output.endsWith('\n'))
+            output += '\n';
+
+        if (!sameTokens(text, script.tokens, output))
+            return source;
+
+        return output;
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+namespace GSC
+{
+	// Strips comments and whitespace from a script. Directives and function
+	// bodies still end their line, tokens only get separated where joining them
+	// would change how they tokenize. Returns the source unchanged if the result
+	// would not tokenize back to the same tokens.
+	QString minify(const QString& source);
+}
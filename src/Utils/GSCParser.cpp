@@ -0,0 +1,503 @@
+#include "GSCParser.h"
+
+namespace GSC
+{
+    namespace
+    {
+        bool isIdentStart(char16_t c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        }
+
+        bool isIdentChar(char16_t c)
+        {
+            return isIdentStart(c) || (c >= '0' && c <= '9');
+        }
+
+        bool isDigit(char16_t c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        // keywords that are followed by '(' but are not calls
+        bool isKeyword(QStringView name)
+        {
+            static const QStringView keywords[] =
+            {
+                u"if", u"while", u"for", u"foreach", u"switch", u"return", u"case", u"else", u"in"
+            };
+
+            for (const auto& keyword : keywords)
+            {
+                if (name.compare(keyword, Qt::CaseInsensitive) == 0)
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    //-----------------------------------------------------
+    // Lexer
+    //-----------------------------------------------------
+    QVector<Token> tokenize(QStringView source)
+    {
+        QVector<Token> tokens;
+        tokens.reserve(source.size() / 4);
+
+        const int size = static_cast<int>(source.size());
+        const QChar* data = source.data();
+        const auto at = [&](int i) -> char16_t { return i < size ? data[i].unicode() : u'\0'; };
+
+        int line = 1;
+        int i = 0;
+
+        // open brackets, true for the [[ of a function pointer call
+        std::vector<bool> brackets;
+
+        while (i < size)
+        {
+            const char16_t c = at(i);
+
+            if (c == '\n')
+            {
+                line++;
+                i++;
+                continue;
+            }
+
+            if (c == ' ' || c == '\t' || c == '\r')
+            {
+                i++;
+                continue;
+            }
+
+            const int start = i;
+            const int startLine = line;
+            TokenType type = TokenType::Punctuation;
+
+            if (c == '/' && at(i + 1) == '/')
+            {
+                type = TokenType::Comment;
+                while (i < size && at(i) != '\n')
+                    i++;
+            }
+            else if (c == '/' && at(i + 1) == '*')
+            {
+                type = TokenType::Comment;
+                i += 2;
+                while (i < size && !(at(i) == '*' && at(i + 1) == '/'))
+                {
+                    if (at(i) == '\n')
+                        line++;
+                    i++;
+                }
+                i = std::min(i + 2, size);
+            }
+            else if (c == '"' || (c == '&' && at(i + 1) == '"'))
+            {
+                type = TokenType::String;
+                i += (c == '&') ? 2 : 1;
+                while (i < size && at(i) != '"' && at(i) != '\n')
+                {
+                    if (at(i) == '\\')
+                        i++;
+                    i++;
+                }
+                i = std::min(i + 1, size);
+            }
+            else if (isIdentStart(c))
+            {
+                type = TokenType::Identifier;
+                while (i < size && (isIdentChar(at(i)) || (at(i) == '\\' && isIdentChar(at(i + 1)))))
+                    i++;
+            }
+            else if (isDigit(c) || (c == '.' && isDigit(at(i + 1))))
+            {
+                type = TokenType::Number;
+                while (i < size && (isIdentChar(at(i)) || at(i) == '.'))
+                    i++;
+            }
+            else if (c == '[')
+            {
+                const bool pointer = at(i + 1) == '[';
+                i += pointer ? 2 : 1;
+                brackets.push_back(pointer);
+            }
+            else if (c == ']')
+            {
+                // ]] only closes a [[, the end of a[b[0]] is two index brackets
+                const bool pointer = !brackets.empty() && brackets.back() && at(i + 1) == ']';
+                i += pointer ? 2 : 1;
+                if (!brackets.empty())
+                    brackets.pop_back();
+            }
+            else
+            {
+                // two character operators first, dev blocks /# #/ included
+                static const char16_t* pairs[] =
+                {
+                    u"::", u"/#", u"#/", u"==", u"!=", u"<=", u">=", u"&&", u"||",
+                    u"++", u"--", u"+=", u"-=", u"*=", u"/=", u"%=", u"|=", u"&=", u"^=", u"<<", u">>"
+                };
+
+                i++;
+                for (const auto* pair : pairs)
+                {
+                    if (pair[0] == c && pair[1] == at(start + 1))
+                    {
+                        i++;
+                        break;
+                    }
+                }
+            }
+
+            tokens.push_back({ type, start, i - start, startLine });
+        }
+
+        return tokens;
+    }
+
+    //-----------------------------------------------------
+    // Parser
+    //-----------------------------------------------------
+    namespace
+    {
+        class Parser
+        {
+        public:
+            explicit Parser(Script& script)
+                : script(script), source(script.source)
+            {
+                // comments never take part in the grammar
+                tokens.reserve(script.tokens.size());
+                for (const auto& token : script.tokens)
+                {
+                    if (token.type != TokenType::Comment)
+                        tokens.push_back(token);
+                }
+            }
+
+            void run()
+            {
+                pos = 0;
+                while (pos < tokens.size())
+                {
+                    if (isPunct(pos, u"#"))
+                    {
+                        parseDirective();
+                    }
+                    else if (isFunctionDefinition(pos))
+                    {
+                        parseFunction();
+                    }
+                    else
+                    {
+                        pos++;
+                    }
+                }
+            }
+
+        private:
+            Script& script;
+            QStringView source;
+            QVector<Token> tokens;
+            qsizetype pos = 0;
+
+            QStringView text(qsizetype index) const
+            {
+                return tokens[index].text(source);
+            }
+
+            bool isPunct(qsizetype index, QStringView punct) const
+            {
+                return index < tokens.size() && tokens[index].type == TokenType::Punctuation && text(index) == punct;
+            }
+
+            bool isIdent(qsizetype index) const
+            {
+                return index < tokens.size() && tokens[index].type == TokenType::Identifier;
+            }
+
+            // name ( params ) {
+            bool isFunctionDefinition(qsizetype index) const
+            {
+                if (!isIdent(index) || !isPunct(index + 1, u"("))
+                    return false;
+
+                qsizetype i = index + 2;
+                while (i < tokens.size() && !isPunct(i, u")"))
+                {
+                    if (!isIdent(i) && !isPunct(i, u","))
+                        return false;
+                    i++;
+                }
+                return isPunct(i + 1, u"{");
+            }
+
+            // #include path; / #using_animtree("name"); / #animtree
+            void parseDirective()
+            {
+                const Token& hash = tokens[pos++];
+
+                Directive directive{};
+                directive.line = hash.line;
+                directive.range.start = hash.start;
+                directive.range.end = hash.end();
+
+                if (!isIdent(pos))
+                    return;
+
+                directive.name = text(pos).toString();
+                directive.range.end = tokens[pos].end();
+                pos++;
+
+                while (pos < tokens.size() && tokens[pos].line == hash.line)
+                {
+                    const Token& token = tokens[pos];
+                    directive.range.end = token.end();
+                    pos++;
+
+                    if (token.type == TokenType::Identifier && directive.value.isEmpty())
+                        directive.value = token.text(source).toString();
+                    else if (token.type == TokenType::String && directive.value.isEmpty())
+                        directive.value = token.text(source).mid(1, token.length - 2).toString();
+                    else if (token.type == TokenType::Punctuation && token.text(source) == u";")
+                        break;
+                }
+
+                script.directives.push_back(std::move(directive));
+            }
+
+            void parseFunction()
+            {
+                Function function{};
+                function.name = text(pos).toString();
+                function.line = tokens[pos].line;
+                function.nameRange = { tokens[pos].start, tokens[pos].end() };
+                function.range.start = tokens[pos].start;
+
+                while (!isPunct(pos, u"{"))
+                    pos++;
+
+                function.bodyOpen = tokens[pos].start;
+                pos++;
+
+                parseBlock(function, 0);
+
+                // parseBlock stops on the matching '}' or at end of file
+                if (pos < tokens.size())
+                {
+                    function.bodyClose = tokens[pos].start;
+                    function.range.end = tokens[pos].end();
+                    pos++;
+                }
+                else
+                {
+                    function.bodyClose = static_cast<int>(source.size());
+                    function.range.end = static_cast<int>(source.size());
+                }
+
+                script.functions.push_back(std::move(function));
+            }
+
+            void parseBlock(Function& function, int depth)
+            {
+                Statement statement{};
+                bool open = false;
+
+                const auto flush = [&](int end)
+                {
+                    if (!open)
+                        return;
+                    statement.range.end = end;
+                    function.statements.push_back(std::move(statement));
+                    statement = {};
+                    open = false;
+                };
+
+                while (pos < tokens.size())
+                {
+                    if (isPunct(pos, u"}"))
+                    {
+                        flush(tokens[pos - 1].end());
+                        return;
+                    }
+
+                    if (isPunct(pos, u"{"))
+                    {
+                        flush(tokens[pos - 1].end());
+                        pos++;
+                        parseBlock(function, depth + 1);
+                        if (pos < tokens.size())
+                            pos++;
+                        continue;
+                    }
+
+                    // dev blocks don't nest scopes, treat their markers as statement boundaries
+                    if (isPunct(pos, u"/#") || isPunct(pos, u"#/"))
+                    {
+                        flush(tokens[pos - 1].end());
+                        pos++;
+                        continue;
+                    }
+
+                    if (!open)
+                    {
+                        open = true;
+                        statement.range.start = tokens[pos].start;
+                        statement.line = tokens[pos].line;
+                        statement.depth = depth;
+                    }
+
+                    if (isPunct(pos, u";"))
+                    {
+                        flush(tokens[pos].end());
+                        pos++;
+                        continue;
+                    }
+
+                    if (isCallStart(pos))
+                    {
+                        statement.calls.push_back(parseCall());
+                        continue;
+                    }
+
+                    pos++;
+                }
+
+                flush(static_cast<int>(source.size()));
+            }
+
+            // [path::]name( or ::name(
+            bool isCallStart(qsizetype index) const
+            {
+                if (isPunct(index, u"::"))
+                    return isIdent(index + 1) && isPunct(index + 2, u"(");
+
+                if (!isIdent(index))
+                    return false;
+
+                if (index > 0 && isPunct(index - 1, u"::"))
+                    return false;
+
+                if (isPunct(index + 1, u"::"))
+                    return isIdent(index + 2) && isPunct(index + 3, u"(");
+
+                return isPunct(index + 1, u"(") && !isKeyword(text(index));
+            }
+
+            Call parseCall()
+            {
+                Call call{};
+                call.line = tokens[pos].line;
+                call.range.start = tokens[pos].start;
+                call.nameRange.start = tokens[pos].start;
+
+                while (!isPunct(pos, u"("))
+                    pos++;
+
+                call.nameRange.end = tokens[pos - 1].end();
+                call.name = call.nameRange.text(source).toString();
+                pos++;
+
+                Argument argument{};
+                bool hasArgument = false;
+                int depth = 0;
+
+                const auto flushArgument = [&]()
+                {
+                    if (hasArgument)
+                        call.args.push_back(std::move(argument));
+                    argument = {};
+                    hasArgument = false;
+                };
+
+                while (pos < tokens.size())
+                {
+                    if (depth == 0 && isPunct(pos, u")"))
+                    {
+                        flushArgument();
+                        call.range.end = tokens[pos].end();
+                        pos++;
+                        return call;
+                    }
+
+                    if (depth == 0 && isPunct(pos, u","))
+                    {
+                        flushArgument();
+                        pos++;
+                        continue;
+                    }
+
+                    if (!hasArgument)
+                    {
+                        hasArgument = true;
+                        argument.range.start = tokens[pos].start;
+                    }
+
+                    if (isCallStart(pos))
+                    {
+                        argument.calls.push_back(parseCall());
+                        argument.range.end = tokens[pos - 1].end();
+                        continue;
+                    }
+
+                    const QStringView punct = tokens[pos].type == TokenType::Punctuation ? text(pos) : QStringView();
+                    if (punct == u"(" || punct == u"[" || punct == u"[[" || punct == u"{")
+                        depth++;
+                    else if (punct == u")" || punct == u"]" || punct == u"]]" || punct == u"}")
+                        depth--;
+
+                    argument.range.end = tokens[pos].end();
+                    pos++;
+                }
+
+                // unterminated call, keep what we have
+                flushArgument();
+                call.range.end = static_cast<int>(source.size());
+                return call;
+            }
+        };
+
+        void visitCalls(const std::vector<Call>& calls, const std::function<void(const Call&)>& visitor)
+        {
+            for (const auto& call : calls)
+            {
+                visitor(call);
+                for (const auto& arg : call.args)
+                    visitCalls(arg.calls, visitor);
+            }
+        }
+    }
+
+    const Function* Script::findFunction(const QString& name) const
+    {
+        for (const auto& function : functions)
+        {
+            if (function.name.compare(name, Qt::CaseInsensitive) == 0)
+                return &function;
+        }
+        return nullptr;
+    }
+
+    void Script::forEachCall(const std::function<void(const Call&)>& visitor) const
+    {
+        for (const auto& function : functions)
+        {
+            for (const auto& statement : function.statements)
+                visitCalls(statement.calls, visitor);
+        }
+    }
+
+    Script parse(QString source)
+    {
+        Script script{};
+        script.source = std::move(source);
+        script.tokens = tokenize(script.source);
+
+        Parser parser(script);
+        parser.run();
+
+        return script;
+    }
+}
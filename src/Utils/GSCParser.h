@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+#include <functional>
+#include <vector>
+
+// Tokenizer and lightweight AST for IW-engine GSC scripts.
+// Everything is a single forward pass over the source, nodes only keep offsets into it.
+namespace GSC
+{
+	enum class TokenType : quint8
+	{
+		Identifier,  // also covers paths such as maps\mp\_utility
+		Number,
+		String,      // "..." and localized &"..."
+		Punctuation,
+		Comment      // line, block comments
+	};
+
+	struct Token
+	{
+		TokenType type;
+		int start;
+		int length;
+		int line;
+
+		int end() const { return start + length; }
+		QStringView text(QStringView source) const { return source.mid(start, length); }
+	};
+
+	QVector<Token> tokenize(QStringView source);
+
+	struct Range
+	{
+		int start = 0;
+		int end = 0;
+
+		int length() const { return end - start; }
+		QStringView text(QStringView source) const { return source.mid(start, end - start); }
+	};
+
+	struct Call;
+
+	struct Argument
+	{
+		Range range;             // trimmed to the argument's first and last token
+		std::vector<Call> calls; // calls directly inside this argument
+	};
+
+	struct Call
+	{
+		QString name;      // as written, e.g. maps\mp\_utility::createLoopEffect
+		Range range;       // from the callee name up to and including ')'
+		Range nameRange;
+		int line = 0;
+		std::vector<Argument> args;
+	};
+
+	struct Statement
+	{
+		Range range;             // ';' included, block braces excluded
+		int line = 0;
+		int depth = 0;           // block depth inside the function body, 0 is the body itself
+		std::vector<Call> calls; // top-level calls, nested calls live in their arguments
+
+		bool startsWithCall() const { return !calls.empty() && calls.front().range.start == range.start; }
+	};
+
+	struct Function
+	{
+		QString name;
+		Range range;     // name up to and including the closing '}'
+		Range nameRange;
+		int bodyOpen = 0;  // offset of '{'
+		int bodyClose = 0; // offset of '}'
+		int line = 0;
+		std::vector<Statement> statements;
+	};
+
+	struct Directive
+	{
+		QString name;  // include, using_animtree, ...
+		QString value; // path or string argument, quotes stripped
+		Range range;
+		int line = 0;
+	};
+
+	struct Script
+	{
+		QString source;
+		QVector<Token> tokens;
+		std::vector<Directive> directives;
+		std::vector<Function> functions;
+
+		const Function* findFunction(const QString& name) const;
+
+		// Visits every call in source order, nested calls after the call containing them
+		void forEachCall(const std::function<void(const Call&)>& visitor) const;
+	};
+
+	Script parse(QString source);
+}
@@ -0,0 +1,232 @@
+#include "GSCRules.h"
+
+#include "../GameTraits.h"
+
+namespace GSC
+{
+    namespace
+    {
+        QString rulesPath(GameType gameType)
+        {
+            return visitSourceGame(gameType, [](auto traits) -> QString
+            {
+                return decltype(traits)::gscRulesPath;
+            });
+        }
+
+        QString expandVariables(QString text, const QHash<QString, QString>& variables)
+        {
+            for (auto it = variables.cbegin(); it != variables.cend(); ++it)
+                text.replace("%" + it.key() + "%", it.value());
+            return text;
+        }
+
+        struct CachedRuleSet
+        {
+            QDateTime lastModified;
+            std::shared_ptr<const RuleSet> rules;
+        };
+    }
+
+    QString FunctionMapping::apply(const QStringList& args) const
+    {
+        QString result;
+        result.reserve(replacement.size() + 32);
+
+        for (qsizetype i = 0; i < replacement.size(); i++)
+        {
+            const QChar c = replacement[i];
+            if (c == '%' && i + 1 < replacement.size() && replacement[i + 1].isDigit())
+            {
+                const int index = replacement[i + 1].digitValue() - 1;
+                if (index >= 0 && index < args.size())
+                    result += args[index];
+                i++;
+                continue;
+            }
+            result += c;
+        }
+
+        return result;
+    }
+
+    std::shared_ptr<const RuleSet> RuleSet::load(GameType gameType)
+    {
+        static QMutex mutex;
+        static QHash<int, CachedRuleSet> cache;
+
+        const QString path = rulesPath(gameType);
+        const QDateTime lastModified = QFileInfo(path).lastModified();
+
+        QMutexLocker lock(&mutex);
+
+        auto cached = cache.find(gameType);
+        if (cached != cache.end() && cached->lastModified == lastModified)
+            return cached->rules;
+
+        // failures are cached too, converting with no rules would quietly do nothing
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            qCritical() << "Failed to open GSC rules file:" << path;
+            cache.insert(gameType, { lastModified, nullptr });
+            return nullptr;
+        }
+
+        QString error;
+        auto rules = fromJson(file.readAll(), &error);
+        file.close();
+
+        if (!rules)
+        {
+            qCritical() << "Failed to parse GSC rules file" << path << ":" << error;
+            cache.insert(gameType, { lastModified, nullptr });
+            return nullptr;
+        }
+
+        qDebug() << "Loaded GSC rules" << rules->name() << "version" << rules->version() << "from" << path;
+
+        cache.insert(gameType, { lastModified, rules });
+        return rules;
+    }
+
+    std::shared_ptr<const RuleSet> RuleSet::fromJson(const QByteArray& data, QString* error)
+    {
+        QJsonParseError parseError;
+        const QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject())
+        {
+            if (error)
+                *error = parseError.errorString();
+            return nullptr;
+        }
+
+        const QJsonObject obj = doc.object();
+
+        auto rules = std::make_shared<RuleSet>();
+        rules->m_version = obj["version"].toInt();
+        rules->m_name = obj["game"].toString();
+
+        for (const auto& value : obj["mappings"].toArray())
+        {
+            const QJsonObject mappingObj = value.toObject();
+
+            FunctionMapping mapping{};
+            mapping.oldName = mappingObj["from"].toString();
+            mapping.newName = mappingObj["to"].toString(mapping.oldName);
+            mapping.minArgs = mappingObj["minArgs"].toInt(-1);
+            mapping.replacement = mappingObj["replace"].toString();
+
+            rules->m_mappings.insert(mapping.oldName.toLower(), mapping);
+        }
+
+        for (const auto& value : obj["removals"].toArray())
+        {
+            const QJsonObject removalObj = value.toObject();
+            rules->m_removals[removalObj["function"].toString().toLower()]
+                .insert(removalObj["call"].toString().toLower());
+        }
+
+        for (const auto& value : obj["insertions"].toArray())
+        {
+            const QJsonObject insertionObj = value.toObject();
+
+            InsertionRule rule{};
+            rule.function = insertionObj["function"].toString();
+            rule.afterCall = insertionObj["after"].toString();
+            rule.insertCode = insertionObj["code"].toString();
+            for (const auto& condition : insertionObj["when"].toArray())
+                rule.conditions << condition.toString();
+
+            rules->m_insertions[rule.function.toLower()].push_back(rule);
+        }
+
+        return rules;
+    }
+
+    const FunctionMapping* RuleSet::findMapping(const QString& callName) const
+    {
+        const auto it = m_mappings.constFind(callName.toLower());
+        return it != m_mappings.constEnd() ? &it.value() : nullptr;
+    }
+
+    bool RuleSet::isRemoved(const QString& function, const QString& callName) const
+    {
+        const auto it = m_removals.constFind(function.toLower());
+        return it != m_removals.constEnd() && it->contains(callName.toLower());
+    }
+
+    bool RuleSet::hasRulesFor(const QString& function) const
+    {
+        const QString key = function.toLower();
+        return m_removals.contains(key) || m_insertions.contains(key);
+    }
+
+    QVector<InsertionRule> RuleSet::insertionsFor(const QString& function, const RuleContext& context) const
+    {
+        QVector<InsertionRule> result;
+
+        const auto it = m_insertions.constFind(function.toLower());
+        if (it == m_insertions.constEnd())
+            return result;
+
+        const auto holds = [&](QString condition)
+        {
+            const bool negate = condition.startsWith('!');
+            if (negate)
+                condition.remove(0, 1);
+
+            bool value = false;
+            if (condition.startsWith("calls:"))
+                value = context.calls && context.calls(expandVariables(condition.mid(6), context.variables));
+            else
+                value = context.flags.contains(condition);
+
+            return value != negate;
+        };
+
+        for (const auto& rule : *it)
+        {
+            if (!std::all_of(rule.conditions.cbegin(), rule.conditions.cend(), holds))
+                continue;
+
+            InsertionRule expanded = rule;
+            expanded.afterCall = expandVariables(rule.afterCall, context.variables);
+            expanded.insertCode = expandVariables(rule.insertCode, context.variables);
+            result.push_back(expanded);
+        }
+
+        return result;
+    }
+
+    const TriggerAction* FunctionTriggers::find(const QString& callName) const
+    {
+        if (byCall.isEmpty())
+            return nullptr;
+
+        const auto it = byCall.constFind(callName.toLower());
+        return it != byCall.constEnd() ? &it.value() : nullptr;
+    }
+
+    FunctionTriggers RuleSet::triggersFor(const QString& function, const RuleContext& context) const
+    {
+        FunctionTriggers triggers;
+
+        const auto removals = m_removals.constFind(function.toLower());
+        if (removals != m_removals.constEnd())
+        {
+            for (const auto& call : *removals)
+                triggers.byCall[call].remove = true;
+        }
+
+        for (const auto& rule : insertionsFor(function, context))
+        {
+            if (rule.afterCall.isEmpty())
+                triggers.insertAtBodyStart << rule.insertCode;
+            else
+                triggers.byCall[rule.afterCall.toLower()].insertAfter << rule.insertCode;
+        }
+
+        return triggers;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+#include "../Shared.h"
+
+#include <memory>
+
+// Conversion rules for GSC scripts, loaded from static/gsc_rules/<game>.json.
+// A rule set is immutable once loaded and shared by every conversion worker.
+namespace GSC
+{
+	struct FunctionMapping
+	{
+		QString oldName;
+		QString newName;
+		int minArgs = -1;
+		QString replacement; // optional, whole call rewritten from %1..%9 argument placeholders
+
+		QString apply(const QStringList& args) const;
+	};
+
+	struct InsertionRule
+	{
+		QString function;
+		QString afterCall;   // empty inserts right after the function's opening brace
+		QString insertCode;
+		QStringList conditions;
+	};
+
+	// Per-file values that rule conditions and %variables% are evaluated against
+	struct RuleContext
+	{
+		QSet<QString> flags;              // hasDestructibles, isMpMap, ...
+		QHash<QString, QString> variables; // map, load
+		std::function<bool(const QString& name)> calls; // whether the script calls name, "*suffix" matches by suffix
+	};
+
+	// What a statement starting with a given call triggers
+	struct TriggerAction
+	{
+		bool remove = false;
+		QStringList insertAfter;
+	};
+
+	// All removal and insertion triggers of one function, resolved for one file.
+	// Every statement costs a single lookup no matter how many rules exist.
+	struct FunctionTriggers
+	{
+		QStringList insertAtBodyStart;
+		QHash<QString, TriggerAction> byCall; // lowercase call name
+
+		bool isEmpty() const { return insertAtBodyStart.isEmpty() && byCall.isEmpty(); }
+		const TriggerAction* find(const QString& callName) const;
+	};
+
+	class RuleSet
+	{
+	public:
+		// Cached per game, reloaded when the rules file changes on disk. Null when the
+		// file is missing or malformed, which is only logged once per version of the file.
+		static std::shared_ptr<const RuleSet> load(GameType gameType);
+		static std::shared_ptr<const RuleSet> fromJson(const QByteArray& data, QString* error = nullptr);
+
+		int version() const { return m_version; }
+		const QString& name() const { return m_name; }
+
+		const FunctionMapping* findMapping(const QString& callName) const;
+		bool isRemoved(const QString& function, const QString& callName) const;
+		bool hasRulesFor(const QString& function) const;
+
+		// Insertion rules for function whose conditions hold, with %variables% expanded
+		QVector<InsertionRule> insertionsFor(const QString& function, const RuleContext& context) const;
+
+		// Removals and insertions for function merged into one table keyed by trigger call
+		FunctionTriggers triggersFor(const QString& function, const RuleContext& context) const;
+
+	private:
+		int m_version = 0;
+		QString m_name;
+
+		// keys are lowercase, GSC function names are case-insensitive
+		QHash<QString, FunctionMapping> m_mappings;
+		QHash<QString, QSet<QString>> m_removals;
+		QHash<QString, QVector<InsertionRule>> m_insertions;
+	};
+}
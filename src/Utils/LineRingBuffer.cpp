@@ -0,0 +1,124 @@
+#include "LineRingBuffer.h"
+
+LineRingBuffer::LineRingBuffer(qsizetype capacity)
+{
+    qsizetype size = 1;
+    while (size < capacity)
+        size <<= 1;
+    m_data.resize(size);
+}
+
+void LineRingBuffer::reserve(qsizetype size)
+{
+    if (size <= m_data.size())
+        return;
+
+    qsizetype capacity = m_data.size();
+    while (capacity < size)
+        capacity <<= 1;
+
+    // unwrap into the new storage
+    QByteArray data(capacity, Qt::Uninitialized);
+    const qsizetype first = std::min(m_size, m_data.size() - m_head);
+    memcpy(data.data(), m_data.constData() + m_head, first);
+    memcpy(data.data() + first, m_data.constData(), m_size - first);
+
+    m_data = std::move(data);
+    m_head = 0;
+}
+
+void LineRingBuffer::readFrom(QIODevice* device)
+{
+    const qint64 available = device->bytesAvailable();
+    if (available <= 0)
+        return;
+
+    reserve(m_size + available);
+
+    // free space is at most two contiguous pieces
+    qint64 remaining = available;
+    while (remaining > 0)
+    {
+        const qsizetype tail = wrap(m_head + m_size);
+        const qsizetype contiguous = std::min<qsizetype>(remaining, (tail >= m_head || m_size == 0)
+            ? m_data.size() - tail
+            : m_head - tail);
+
+        const qint64 read = device->read(m_data.data() + tail, contiguous);
+        if (read <= 0)
+            break;
+
+        m_size += read;
+        remaining -= read;
+    }
+}
+
+void LineRingBuffer::append(const char* data, qsizetype size)
+{
+    reserve(m_size + size);
+
+    const qsizetype tail = wrap(m_head + m_size);
+    const qsizetype first = std::min(size, m_data.size() - tail);
+    memcpy(m_data.data() + tail, data, first);
+    memcpy(m_data.data(), data + first, size - first);
+
+    m_size += size;
+}
+
+void LineRingBuffer::takeLines(const std::function<void(QByteArrayView)>& onLine, bool flush)
+{
+    const auto emitLine = [&](qsizetype length)
+    {
+        QByteArrayView line;
+        if (m_head + length <= m_data.size())
+        {
+            line = QByteArrayView(m_data.constData() + m_head, length);
+        }
+        else
+        {
+            const qsizetype first = m_data.size() - m_head;
+            m_scratch.resize(length);
+            memcpy(m_scratch.data(), m_data.constData() + m_head, first);
+            memcpy(m_scratch.data() + first, m_data.constData(), length - first);
+            line = m_scratch;
+        }
+
+        if (line.endsWith('\r'))
+            line.chop(1);
+
+        onLine(line);
+    };
+
+    while (m_scanned < m_size)
+    {
+        // search the unscanned bytes one contiguous piece at a time
+        const qsizetype start = wrap(m_head + m_scanned);
+        const qsizetype contiguous = std::min(m_size - m_scanned, m_data.size() - start);
+        const char* piece = m_data.constData() + start;
+        const char* newline = static_cast<const char*>(memchr(piece, '\n', contiguous));
+
+        if (!newline)
+        {
+            m_scanned += contiguous;
+            continue;
+        }
+
+        m_scanned += newline - piece;
+        emitLine(m_scanned);
+
+        m_head = wrap(m_head + m_scanned + 1);
+        m_size -= m_scanned + 1;
+        m_scanned = 0;
+    }
+
+    if (m_size == 0)
+        m_head = 0;
+
+    if (flush && m_size > 0)
+    {
+        emitLine(m_size);
+        m_head = 0;
+        m_size = 0;
+        m_scanned = 0;
+    }
+}
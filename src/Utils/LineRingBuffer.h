@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QtWidgets/QtWidgets>
+
+// Byte ring buffer that hands out complete '\n' terminated lines and keeps
+// the unterminated tail around for the next read
+class LineRingBuffer
+{
+public:
+	explicit LineRingBuffer(qsizetype capacity = 64 * 1024);
+
+	// Reads everything available on device straight into the ring
+	void readFrom(QIODevice* device);
+	void append(const char* data, qsizetype size);
+
+	// Calls onLine for every complete line, without its "\r\n" / "\n".
+	// With flush the unterminated tail counts as a line too.
+	void takeLines(const std::function<void(QByteArrayView)>& onLine, bool flush = false);
+
+	qsizetype size() const { return m_size; }
+
+private:
+	void reserve(qsizetype size);
+	qsizetype wrap(qsizetype index) const { return index & (m_data.size() - 1); }
+
+	QByteArray m_data;    // size is a power of two
+	qsizetype m_head = 0; // first unread byte
+	qsizetype m_size = 0;
+	qsizetype m_scanned = 0; // bytes after head already known to hold no '\n'
+	QByteArray m_scratch; // lines that wrap around the end are copied here
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// Unbounded multi producer, single consumer queue (Vyukov's intrusive design).
+// push never blocks and never takes a lock, so any thread can call it, even from
+// inside a message handler. tryPop belongs to one consumer thread.
+template <typename T>
+class MpscQueue
+{
+public:
+	MpscQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+
+	~MpscQueue()
+	{
+		T value;
+		while (tryPop(value)) {}
+	}
+
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue& operator=(const MpscQueue&) = delete;
+
+	void push(T value)
+	{
+		Node* node = new Node;
+		node->value = std::move(value);
+		pushNode(node);
+	}
+
+	// False when empty, or when the only producer left is halfway through its push
+	bool tryPop(T& value)
+	{
+		Node* tail = m_tail;
+		Node* next = tail->next.load(std::memory_order_acquire);
+
+		if (tail == &m_stub)
+		{
+			if (!next)
+				return false;
+
+			m_tail = next;
+			tail = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+
+		if (next)
+		{
+			m_tail = next;
+			value = std::move(tail->value);
+			delete tail;
+			return true;
+		}
+
+		if (tail != m_head.load(std::memory_order_acquire))
+			return false;
+
+		// tail is the last node, put the stub behind it so it can be handed out
+		pushNode(&m_stub);
+
+		next = tail->next.load(std::memory_order_acquire);
+		if (!next)
+			return false;
+
+		m_tail = next;
+		value = std::move(tail->value);
+		delete tail;
+		return true;
+	}
+
+private:
+	struct Node
+	{
+		std::atomic<Node*> next = nullptr;
+		T value{};
+	};
+
+	void pushNode(Node* node)
+	{
+		node->next.store(nullptr, std::memory_order_relaxed);
+		Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+		previous->next.store(node, std::memory_order_release);
+	}
+
+	Node m_stub;
+	std::atomic<Node*> m_head; // producers link in here
+	Node* m_tail;              // consumer pops from here
+};
@@ -0,0 +1,150 @@
+#include "ZonetoolHotspots.h"
+#include "ZonetoolProgress.h"
+
+namespace
+{
+    QVector<ZonetoolHotspots::Entry> slowest(QVector<ZonetoolHotspots::Entry> entries, int count)
+    {
+        const auto byTime = [](const ZonetoolHotspots::Entry& a, const ZonetoolHotspots::Entry& b)
+        {
+            return a.us > b.us;
+        };
+
+        if (count < entries.size())
+        {
+            std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), byTime);
+            entries.resize(count);
+        }
+        else
+        {
+            std::sort(entries.begin(), entries.end(), byTime);
+        }
+
+        return entries;
+    }
+
+    QString formatMs(qint64 us)
+    {
+        return QString::number(us / 1000.0, 'f', 1) + " ms";
+    }
+}
+
+void ZonetoolHotspots::charge(qint64 untilUs)
+{
+    if (m_lastUs < 0)
+    {
+        m_lastUs = untilUs;
+        return;
+    }
+
+    const qint64 elapsed = std::max<qint64>(0, untilUs - m_lastUs);
+    m_lastUs = untilUs;
+    m_totalUs += elapsed;
+
+    if (m_current.isEmpty())
+        m_unattributedUs += elapsed;
+    else
+        m_assets[m_current].us += elapsed;
+}
+
+void ZonetoolHotspots::feed(QByteArrayView line, qint64 receivedUs)
+{
+    charge(receivedUs);
+
+    const auto event = ZonetoolProgress::parse(line);
+    if (!event || event->assetName.isEmpty())
+        return;
+
+    m_current = event->assetType + '/' + event->assetName;
+
+    Entry& entry = m_assets[m_current];
+    if (entry.count++ == 0)
+    {
+        entry.type = event->assetType;
+        entry.name = event->assetName;
+    }
+}
+
+void ZonetoolHotspots::finish(qint64 endUs)
+{
+    charge(endUs);
+    m_current.clear();
+}
+
+QVector<ZonetoolHotspots::Entry> ZonetoolHotspots::slowestAssets(int count) const
+{
+    return slowest(m_assets.values(), count);
+}
+
+QVector<ZonetoolHotspots::Entry> ZonetoolHotspots::slowestTypes(int count) const
+{
+    QHash<QString, Entry> types;
+    for (const auto& asset : m_assets)
+    {
+        Entry& type = types[asset.type];
+        type.type = asset.type;
+        type.us += asset.us;
+        type.count++;
+    }
+
+    return slowest(types.values(), count);
+}
+
+void ZonetoolHotspots::logReport(const QString& zone, int count) const
+{
+    if (m_assets.isEmpty())
+        return;
+
+    QStringList lines;
+    lines << QString("Slowest assets building %1 (%2 total, %3 before the first asset):")
+        .arg(zone, formatMs(m_totalUs), formatMs(m_unattributedUs));
+
+    for (const auto& asset : slowestAssets(count))
+        lines << QString("  %1  %2 %3").arg(formatMs(asset.us), 12).arg(asset.type.isEmpty() ? "?" : asset.type, asset.name);
+
+    lines << "Slowest asset types:";
+    for (const auto& type : slowestTypes(count))
+        lines << QString("  %1  %2 (%3 assets)").arg(formatMs(type.us), 12).arg(type.type.isEmpty() ? "?" : type.type).arg(type.count);
+
+    qInfo().noquote() << lines.join('\n');
+}
+
+bool ZonetoolHotspots::saveReport(const QString& path, const QString& zone, int count) const
+{
+    const auto toJson = [](const QVector<Entry>& entries, bool withName)
+    {
+        QJsonArray array;
+        for (const auto& entry : entries)
+        {
+            QJsonObject object;
+            object["type"] = entry.type;
+            if (withName)
+                object["name"] = entry.name;
+            else
+                object["assets"] = entry.count;
+            object["ms"] = entry.us / 1000.0;
+            array << object;
+        }
+        return array;
+    };
+
+    QJsonObject root;
+    root["zone"] = zone;
+    root["date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["totalMs"] = m_totalUs / 1000.0;
+    root["unattributedMs"] = m_unattributedUs / 1000.0;
+    root["assets"] = toJson(slowestAssets(count), true);
+    root["types"] = toJson(slowestTypes(count), false);
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qWarning() << "Failed to write hotspot report" << path;
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Globals.h"
+
+// Where a zonetool build spends its time. The time between two output lines goes to
+// the asset the first of them named, lines that name none keep the clock on the
+// asset before them.
+class ZonetoolHotspots
+{
+public:
+    struct Entry
+    {
+        QString type;
+        QString name;       // empty for asset type totals
+        qint64 us = 0;
+        int count = 0;      // lines that named it, assets for a type total
+    };
+
+    // Call with the process launch time on the clock feed() gets, so the wait for the
+    // first line is counted too. Without it the clock starts at the first line.
+    void start(qint64 startUs) { m_lastUs = startUs; }
+
+    // receivedUs is when the line came in, on any clock that doesn't jump
+    void feed(QByteArrayView line, qint64 receivedUs);
+
+    // Charges the time since the last line, call once the process exited
+    void finish(qint64 endUs);
+
+    QVector<Entry> slowestAssets(int count) const;
+    QVector<Entry> slowestTypes(int count) const;
+
+    qint64 totalUs() const { return m_totalUs; }
+    qint64 unattributedUs() const { return m_unattributedUs; }
+
+    void logReport(const QString& zone, int count) const;
+    bool saveReport(const QString& path, const QString& zone, int count) const;
+
+private:
+    void charge(qint64 untilUs);
+
+    QHash<QString, Entry> m_assets;     // type/name
+    QString m_current;
+    qint64 m_lastUs = -1;
+    qint64 m_totalUs = 0;
+    qint64 m_unattributedUs = 0;        // before the first asset line
+};
@@ -0,0 +1,210 @@
+#include "ZonetoolProgress.h"
+
+namespace
+{
+    enum class Verb
+    {
+        None,
+        Loaded,
+        Written
+    };
+
+    // zonetool words its progress lines differently between dumping and building,
+    // only the leading verb tells them apart
+    Verb classifyVerb(QStringView word)
+    {
+        static const QHash<QString, Verb> verbs = {
+            { "loading", Verb::Loaded },  { "loaded", Verb::Loaded },
+            { "adding", Verb::Loaded },   { "added", Verb::Loaded },
+            { "parsing", Verb::Loaded },  { "parsed", Verb::Loaded },
+            { "dumping", Verb::Written }, { "dumped", Verb::Written },
+            { "writing", Verb::Written }, { "wrote", Verb::Written },
+            { "written", Verb::Written },
+        };
+
+        return verbs.value(word.toString().toLower(), Verb::None);
+    }
+
+    qint64 toBytes(double value, QStringView unit)
+    {
+        const QString lower = unit.toString().toLower();
+        if (lower == u"kb")
+            return static_cast<qint64>(value * 1024.0);
+        if (lower == u"mb")
+            return static_cast<qint64>(value * 1024.0 * 1024.0);
+        if (lower == u"gb")
+            return static_cast<qint64>(value * 1024.0 * 1024.0 * 1024.0);
+        return static_cast<qint64>(value);
+    }
+
+    qint64 findSize(const QString& text)
+    {
+        static const QRegularExpression size(R"((\d+(?:\.\d+)?)\s*(bytes|b|kb|mb|gb)\b)", QRegularExpression::CaseInsensitiveOption);
+
+        const auto match = size.match(text);
+        return match.hasMatch() ? toBytes(match.captured(1).toDouble(), match.capturedView(2)) : -1;
+    }
+}
+
+ZonetoolProgress::ZonetoolProgress(const QString& zone, int expectedAssets)
+    : m_zone(zone), m_expected(expectedAssets)
+{
+    m_clock.start();
+}
+
+std::optional<ZonetoolEvent> ZonetoolProgress::parse(QByteArrayView line)
+{
+    // leftover "[ LEVEL ]" prefixes are skipped, readOutputFromProcess normally strips them
+    while (line.startsWith('['))
+    {
+        const qsizetype end = line.indexOf(']');
+        if (end < 0)
+            break;
+        line = line.sliced(end + 1).trimmed();
+    }
+
+    if (line.isEmpty())
+        return std::nullopt;
+
+    const QString text = QString::fromLocal8Bit(line);
+
+    // Dumping xmodel "name" / Loading asset "name" of type xmodel / Wrote xmodel: name (1234 bytes)
+    static const QRegularExpression asset(
+        R"(^(\w+)\s+(?:asset\s+)?(?:"([^"]+)"(?:\s+(?:of\s+type|type:?)\s+"?(\w+)"?)?|([a-z_]\w*)\s*:?\s+"?([^"\s]+)"?))",
+        QRegularExpression::CaseInsensitiveOption);
+
+    const auto match = asset.match(text);
+    if (match.hasMatch())
+    {
+        const Verb verb = classifyVerb(match.capturedView(1));
+        if (verb != Verb::None)
+        {
+            ZonetoolEvent event;
+            event.kind = verb == Verb::Loaded ? ZonetoolEvent::Kind::AssetLoaded : ZonetoolEvent::Kind::AssetWritten;
+            event.assetName = match.hasCaptured(2) ? match.captured(2) : match.captured(5);
+            event.assetType = (match.hasCaptured(2) ? match.captured(3) : match.captured(4)).toLower();
+            event.bytes = findSize(text);
+
+            // "Loading zone mp_foo" and the like describe the whole run, not one asset
+            if (event.assetType != u"zone" && event.assetType != u"fastfile")
+                return event;
+        }
+    }
+
+    // Fastfile size: 12.34 MB
+    if (text.contains(u"size", Qt::CaseInsensitive))
+    {
+        const qint64 bytes = findSize(text);
+        if (bytes >= 0)
+            return ZonetoolEvent{ ZonetoolEvent::Kind::ZoneSize, {}, {}, bytes };
+    }
+
+    return std::nullopt;
+}
+
+bool ZonetoolProgress::feed(QByteArrayView line)
+{
+    const auto event = parse(line);
+    if (!event)
+        return false;
+
+    switch (event->kind)
+    {
+    case ZonetoolEvent::Kind::AssetLoaded:
+        m_loaded++;
+        break;
+    case ZonetoolEvent::Kind::AssetWritten:
+        m_written++;
+        break;
+    case ZonetoolEvent::Kind::ZoneSize:
+        m_bytes = std::max(m_bytes, event->bytes);
+        return true;
+    }
+
+    if (event->bytes > 0)
+        m_bytes += event->bytes;
+
+    // a dump only writes and a build mostly loads, count each asset under the phase the run reports
+    if (!event->assetType.isEmpty() && (event->kind == ZonetoolEvent::Kind::AssetWritten || m_written == 0))
+        m_countsByType[event->assetType]++;
+
+    return true;
+}
+
+ZonetoolProgress::Snapshot ZonetoolProgress::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.loaded = m_loaded;
+    snapshot.written = m_written;
+    snapshot.expected = m_expected;
+
+    const double seconds = m_clock.elapsed() / 1000.0;
+    const int done = std::max(m_loaded, m_written);
+    if (seconds > 0.0)
+    {
+        snapshot.assetsPerSecond = done / seconds;
+        snapshot.megabytesPerSecond = m_bytes / (1024.0 * 1024.0) / seconds;
+    }
+
+    if (m_expected > 0 && snapshot.assetsPerSecond > 0.0)
+        snapshot.etaSeconds = static_cast<qint64>(std::max(0, m_expected - done) / snapshot.assetsPerSecond);
+
+    return snapshot;
+}
+
+bool ZonetoolProgress::saveCounts(const QString& path) const
+{
+    QJsonObject counts;
+    for (auto it = m_countsByType.cbegin(); it != m_countsByType.cend(); ++it)
+        counts[it.key()] = it.value();
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    file.write(QJsonDocument(counts).toJson());
+    return true;
+}
+
+QMap<QString, int> ZonetoolProgress::loadCounts(const QString& path)
+{
+    QMap<QString, int> counts;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return counts;
+
+    const QJsonObject object = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it)
+        counts.insert(it.key(), it.value().toInt());
+
+    return counts;
+}
+
+void ZonetoolProgress::logCountChanges(const QMap<QString, int>& previous) const
+{
+    if (previous.isEmpty() || m_countsByType.isEmpty())
+        return;
+
+    QStringList changes;
+
+    QSet<QString> types(m_countsByType.keyBegin(), m_countsByType.keyEnd());
+    types.unite(QSet<QString>(previous.keyBegin(), previous.keyEnd()));
+
+    QStringList sorted = types.values();
+    sorted.sort();
+    for (const QString& type : sorted)
+    {
+        const int now = m_countsByType.value(type);
+        const int before = previous.value(type);
+        if (now != before)
+            changes << QString("%1 %2 (%3%4)").arg(type).arg(now).arg(now > before ? "+" : "").arg(now - before);
+    }
+
+    if (changes.isEmpty())
+        qDebug() << "Asset counts for" << m_zone << "match the previous run";
+    else
+        qInfo().noquote() << QString("Asset counts for %1 changed since the previous run: %2").arg(m_zone, changes.join(", "));
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Globals.h"
+
+// A zonetool output line that says how far a dump or build got
+struct ZonetoolEvent
+{
+    enum class Kind
+    {
+        AssetLoaded,    // read from zone source or the zone being dumped
+        AssetWritten,   // dumped to disk or written into the fastfile
+        ZoneSize        // fastfile size reported at the end of a build
+    };
+
+    Kind kind = Kind::AssetLoaded;
+    QString assetType;  // lowercase, empty when the line doesn't name one
+    QString assetName;
+    qint64 bytes = -1;  // -1 when the line carries no size
+};
+
+// Turns the lines of one zonetool run into events and keeps counts and rates over them
+class ZonetoolProgress
+{
+public:
+    struct Snapshot
+    {
+        int loaded = 0;
+        int written = 0;
+        int expected = 0;           // 0 when unknown
+        double assetsPerSecond = 0.0;
+        double megabytesPerSecond = 0.0;
+        qint64 etaSeconds = -1;     // -1 when unknown
+    };
+
+    // expectedAssets is the asset count the run will reach, 0 when unknown
+    explicit ZonetoolProgress(const QString& zone, int expectedAssets = 0);
+
+    static std::optional<ZonetoolEvent> parse(QByteArrayView line);
+
+    // Parses line and accounts for it, returns whether it was a progress line
+    bool feed(QByteArrayView line);
+
+    Snapshot snapshot() const;
+
+    const QString& zone() const { return m_zone; }
+    const QMap<QString, int>& countsByType() const { return m_countsByType; }
+
+    // Per asset type counts, kept so the next run of the same zone can be compared against them
+    bool saveCounts(const QString& path) const;
+    static QMap<QString, int> loadCounts(const QString& path);
+
+    // Logs the asset types whose count changed since previous
+    void logCountChanges(const QMap<QString, int>& previous) const;
+
+private:
+    QString m_zone;
+    int m_expected = 0;
+    int m_loaded = 0;
+    int m_written = 0;
+    qint64 m_bytes = 0;
+    QMap<QString, int> m_countsByType;
+    QElapsedTimer m_clock;
+};
@@ -2,13 +2,12 @@
 
 #include <QApplication>
 
+#ifdef Q_OS_WIN
 #include <Windows.h>
+#endif
 
-int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
+static int run(int argc, char** argv)
 {
-    int argc = 0;
-    char** argv = nullptr;
-
     QApplication a(argc, argv);
 
     QCoreApplication::setOrganizationDomain("auroramod.dev");
@@ -19,4 +18,18 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     w.show();
 
     return a.exec();
-}
\ No newline at end of file
+}
+
+#ifdef Q_OS_WIN
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
+{
+    int argc = 0;
+    char** argv = nullptr;
+    return run(argc, argv);
+}
+#else
+int main(int argc, char** argv)
+{
+    return run(argc, argv);
+}
+#endif
\ No newline at end of file
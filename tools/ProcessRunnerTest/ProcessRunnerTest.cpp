@@ -0,0 +1,6 @@
+// Runs ProcessRunner's worker mode against the zonetool stand-in, see tools/ZonetoolStandIn.
+// The stand-in is looked for in standin/ next to this executable, ZONETOOL_STANDIN overrides it.
+
+#include "ProcessRunnerTest.h"
+
+QTEST_GUILESS_MAIN(ProcessRunnerTest)
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "ProcessRunner.h"
+
+#include <QtTest/QtTest>
+
+class ProcessRunnerTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    struct Result
+    {
+        int exitCode = -2; // not finished yet
+        QStringList lines;
+    };
+
+    static QStringList buildZone(const QString& zone)
+    {
+        return { "-unbuffered-io", "-buildzone", zone };
+    }
+
+    static int countSamples(ProcessRunner& runner, bool worker)
+    {
+        int count = 0;
+        for (const auto& sample : runner.telemetry().samples())
+        {
+            if (sample.name.endsWith(" (worker)") == worker)
+                count++;
+        }
+        return count;
+    }
+
+    QFileInfo m_standIn;
+
+    // the command's exit code and output lines show up in result once it finished
+    void runInWorker(ProcessRunner& runner, const QStringList& args, std::shared_ptr<Result> result)
+    {
+        runner.runInWorker(m_standIn, args, [result](int exitCode) {
+            result->exitCode = exitCode;
+        }, [result](QByteArrayView line, qint64) {
+            result->lines << QString::fromUtf8(line);
+        });
+    }
+
+private slots:
+    void initTestCase()
+    {
+        const QString overridden = qEnvironmentVariable("ZONETOOL_STANDIN");
+#ifdef Q_OS_WIN
+        const QString name = "zonetool.exe";
+#else
+        const QString name = "zonetool";
+#endif
+        m_standIn = QFileInfo(overridden.isEmpty() ? QCoreApplication::applicationDirPath() + "/standin/" + name : overridden);
+        QVERIFY2(m_standIn.exists(), qPrintable("No stand-in at " + m_standIn.absoluteFilePath()));
+
+        qputenv("ZONETOOL_STANDIN_LOAD_MS", "500");
+        qputenv("ZONETOOL_STANDIN_ASSET_MS", "5");
+    }
+
+    void init()
+    {
+        qunsetenv("ZONETOOL_STANDIN_NO_WORKER");
+    }
+
+    void queuedCommandsShareOneWorker()
+    {
+        ProcessRunner runner;
+        auto first = std::make_shared<Result>();
+        auto second = std::make_shared<Result>();
+        auto third = std::make_shared<Result>();
+
+        runInWorker(runner, buildZone("mp_first"), first);
+        runInWorker(runner, buildZone("mp second"), second);
+        runInWorker(runner, { "-unbuffered-io", "-dumpzone", "mp_third" }, third);
+
+        QTRY_COMPARE_WITH_TIMEOUT(third->exitCode, 0, 10000);
+        QCOMPARE(first->exitCode, 0);
+        QCOMPARE(second->exitCode, 0);
+
+        // output belongs to the command that printed it, frame lines to nobody
+        QVERIFY(first->lines.join('\n').contains("\"mp_first\""));
+        QVERIFY(!first->lines.join('\n').contains("mp second"));
+        QVERIFY(second->lines.join('\n').contains("\"mp second\""));
+        for (const auto* result : { first.get(), second.get(), third.get() })
+        {
+            for (const QString& line : result->lines)
+                QVERIFY2(!line.startsWith("@@"), qPrintable(line));
+        }
+
+        QCOMPARE(countSamples(runner, true), 3);
+        QCOMPARE(countSamples(runner, false), 0);
+
+        runner.stopWorkers();
+    }
+
+    void failingCommandKeepsTheWorker()
+    {
+        ProcessRunner runner;
+        auto failing = std::make_shared<Result>();
+        auto next = std::make_shared<Result>();
+
+        runInWorker(runner, { "-unbuffered-io", "-bogus" }, failing);
+        runInWorker(runner, buildZone("mp_next"), next);
+
+        QTRY_COMPARE_WITH_TIMEOUT(next->exitCode, 0, 10000);
+        QCOMPARE(failing->exitCode, 1);
+        QCOMPARE(countSamples(runner, true), 2);
+
+        runner.stopWorkers();
+    }
+
+    void crashedWorkerRerunsItsCommandsOneShot()
+    {
+        ProcessRunner runner;
+        auto crashing = std::make_shared<Result>();
+        auto queued = std::make_shared<Result>();
+
+        runInWorker(runner, buildZone("crash"), crashing);
+        runInWorker(runner, buildZone("mp_queued"), queued);
+
+        QTRY_COMPARE_WITH_TIMEOUT(queued->exitCode, 0, 10000);
+        QTRY_COMPARE_WITH_TIMEOUT(crashing->exitCode, 3, 10000);
+        QCOMPARE(countSamples(runner, false), 2);
+
+        // it did get ready, so the next command tries a worker again
+        auto after = std::make_shared<Result>();
+        runInWorker(runner, buildZone("mp_after"), after);
+        QTRY_COMPARE_WITH_TIMEOUT(after->exitCode, 0, 10000);
+        QCOMPARE(countSamples(runner, true), 2); // the crashed command and this one
+
+        runner.stopWorkers();
+    }
+
+    void toolWithoutWorkerModeFallsBackToOneShot()
+    {
+        qputenv("ZONETOOL_STANDIN_NO_WORKER", "1");
+
+        ProcessRunner runner;
+        auto first = std::make_shared<Result>();
+        auto second = std::make_shared<Result>();
+
+        runInWorker(runner, buildZone("mp_first"), first);
+        runInWorker(runner, buildZone("mp_second"), second);
+
+        QTRY_COMPARE_WITH_TIMEOUT(second->exitCode, 0, 10000);
+        QTRY_COMPARE_WITH_TIMEOUT(first->exitCode, 0, 10000);
+
+        auto later = std::make_shared<Result>();
+        runInWorker(runner, buildZone("mp_later"), later);
+        QTRY_COMPARE_WITH_TIMEOUT(later->exitCode, 0, 10000);
+
+        QCOMPARE(countSamples(runner, true), 0);
+        QCOMPARE(countSamples(runner, false), 3);
+    }
+
+    void stopBeforeReadyKeepsWorkerMode()
+    {
+        ProcessRunner runner;
+        auto early = std::make_shared<Result>();
+
+        // still loading its common zones when it's told to go
+        runInWorker(runner, buildZone("mp_early"), early);
+        runner.stopWorkers();
+
+        QTRY_COMPARE_WITH_TIMEOUT(early->exitCode, 0, 10000);
+
+        auto later = std::make_shared<Result>();
+        runInWorker(runner, buildZone("mp_later"), later);
+        QTRY_COMPARE_WITH_TIMEOUT(later->exitCode, 0, 10000);
+        QCOMPARE(countSamples(runner, true), 1);
+
+        runner.stopWorkers();
+    }
+};
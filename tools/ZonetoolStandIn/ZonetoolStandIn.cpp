@@ -0,0 +1,221 @@
+// Stands in for zonetool.exe so ProcessRunner's worker mode can be run without the game.
+//
+// One-shot, like the real tool:  zonetool -unbuffered-io -buildzone <zone>
+// As a worker:                   zonetool -worker -unbuffered-io
+//   prints "@@ready" once its common zones are "loaded", then reads one command per
+//   line from stdin, prints its output and "@@done <exit code>", and exits once stdin
+//   is closed.
+//
+// Environment:
+//   ZONETOOL_STANDIN_LOAD_MS   time spent loading common zones at start, 1500 by default
+//   ZONETOOL_STANDIN_ASSET_MS  time spent per asset, 20 by default
+//   ZONETOOL_STANDIN_NO_WORKER ignores -worker like a zonetool without worker mode would
+//   ZONETOOL_STANDIN_CAPTURE   -buildzone replays this capture instead of its own few assets,
+//                              see captures/ and capture.py
+//
+// A zone named "crash" makes the process exit halfway through the command.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    int envMs(const char* name, int fallback)
+    {
+        const char* value = std::getenv(name);
+        return value ? std::atoi(value) : fallback;
+    }
+
+    void sleepMs(int ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+
+    void printLine(const std::string& line)
+    {
+        // the runner times lines by when they arrive, so every line goes out on its own
+        std::fputs(line.c_str(), stdout);
+        std::fputc('\n', stdout);
+        std::fflush(stdout);
+    }
+
+    // The worker gets arguments space separated, quoted when they contain spaces
+    std::vector<std::string> splitCommand(const std::string& line)
+    {
+        std::vector<std::string> args;
+        std::string current;
+        bool quoted = false;
+        bool any = false;
+
+        for (const char c : line)
+        {
+            if (c == '"')
+            {
+                quoted = !quoted;
+                any = true;
+            }
+            else if (c == ' ' && !quoted)
+            {
+                if (any)
+                    args.push_back(current);
+                current.clear();
+                any = false;
+            }
+            else if (c != '\r')
+            {
+                current += c;
+                any = true;
+            }
+        }
+
+        if (any)
+            args.push_back(current);
+        return args;
+    }
+
+    void loadCommonZones()
+    {
+        printLine("[ INFO ] Loading common zones");
+        sleepMs(envMs("ZONETOOL_STANDIN_LOAD_MS", 1500));
+        printLine("[ INFO ] Common zones loaded");
+    }
+
+    // Lines of a capture are "<ms since the command started>\t<line>", they're printed
+    // at those times so the hotspot report sees the original gaps between them
+    int replayCapture(const char* path)
+    {
+        std::ifstream capture(path);
+        if (!capture)
+        {
+            printLine(std::string("[ ERROR ] Can't open capture ") + path);
+            return EXIT_FAILURE;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::string line;
+        while (std::getline(capture, line))
+        {
+            const size_t tab = line.find('\t');
+            if (tab == std::string::npos)
+                continue;
+
+            std::this_thread::sleep_until(start + std::chrono::milliseconds(std::atoll(line.c_str())));
+            printLine(line.substr(tab + 1));
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    int buildZone(const std::string& zone)
+    {
+        if (const char* capture = std::getenv("ZONETOOL_STANDIN_CAPTURE"))
+            return replayCapture(capture);
+
+        struct Asset
+        {
+            const char* type;
+            const char* name;
+        };
+
+        static const Asset assets[] = {
+            { "rawfile", "maps/mp/%s.gsc" },
+            { "material", "mc/mtl_%s_ground" },
+            { "xmodel", "%s_skybox" },
+            { "image", "%s_ground_col" },
+            { "clipmap", "maps/mp/%s.d3dbsp" },
+            { "gfxworld", "maps/mp/%s.d3dbsp" },
+        };
+
+        const int assetMs = envMs("ZONETOOL_STANDIN_ASSET_MS", 20);
+
+        printLine("[ INFO ] Building zone \"" + zone + "\"");
+        for (const Asset& asset : assets)
+        {
+            if (zone == "crash" && std::string(asset.type) == "xmodel")
+            {
+                printLine("[ FATAL ] Crashed while loading an xmodel");
+                std::exit(3);
+            }
+
+            char name[256];
+            std::snprintf(name, sizeof(name), asset.name, zone.c_str());
+            printLine(std::string("[ INFO ] Loading asset \"") + name + "\" of type " + asset.type);
+            sleepMs(assetMs);
+        }
+
+        printLine("[ INFO ] Fastfile size: 1.25 MB");
+        return EXIT_SUCCESS;
+    }
+
+    int dumpZone(const std::string& zone)
+    {
+        printLine("[ INFO ] Dumping zone \"" + zone + "\"");
+        printLine("[ INFO ] Dumping rawfile \"maps/mp/" + zone + ".gsc\"");
+        sleepMs(envMs("ZONETOOL_STANDIN_ASSET_MS", 20));
+        return EXIT_SUCCESS;
+    }
+
+    int runCommand(const std::vector<std::string>& args)
+    {
+        for (size_t i = 0; i < args.size(); i++)
+        {
+            if (args[i] == "-unbuffered-io")
+                continue;
+
+            if ((args[i] == "-buildzone" || args[i] == "-dumpzone") && i + 1 < args.size())
+                return args[i] == "-buildzone" ? buildZone(args[i + 1]) : dumpZone(args[i + 1]);
+
+            printLine("[ ERROR ] Unknown argument " + args[i]);
+            return EXIT_FAILURE;
+        }
+
+        printLine("[ ERROR ] Nothing to do");
+        return EXIT_FAILURE;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    bool worker = false;
+    for (auto it = args.begin(); it != args.end();)
+    {
+        if (*it == "-worker")
+        {
+            worker = !std::getenv("ZONETOOL_STANDIN_NO_WORKER");
+            it = args.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    loadCommonZones();
+
+    if (!worker)
+        return runCommand(args);
+
+    printLine("@@ready");
+
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        const std::vector<std::string> command = splitCommand(line);
+        if (command.empty())
+            continue;
+
+        const int exitCode = runCommand(command);
+        printLine("@@done " + std::to_string(exitCode));
+    }
+
+    return EXIT_SUCCESS;
+}
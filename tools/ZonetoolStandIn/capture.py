@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+"""Records a tool's output with the time each line arrived, for the zonetool stand-in to replay.
+
+    python tools/ZonetoolStandIn/capture.py zonetool.exe -unbuffered-io -buildzone mp_foo > captures/buildzone_mp_foo.log
+
+Each line comes out as "<ms since the tool started>\\t<line>".
+"""
+
+import subprocess
+import sys
+import time
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__, file=sys.stderr)
+        return 2
+
+    start = time.monotonic()
+    process = subprocess.Popen(sys.argv[1:], stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+
+    for line in iter(process.stdout.readline, b""):
+        ms = int((time.monotonic() - start) * 1000)
+        text = line.decode(errors="replace").rstrip("\r\n")
+        sys.stdout.write("%d\t%s\n" % (ms, text))
+        sys.stdout.flush()
+
+    return process.wait()
+
+
+if __name__ == "__main__":
+    sys.exit(main())